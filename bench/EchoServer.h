@@ -0,0 +1,174 @@
+/**
+ * @file EchoServer.h
+ * @brief Embedded loopback echo server speaking the Message framing
+ *
+ * Used by the benchmarks: every complete [Length][Body] frame received on a
+ * session is written back unchanged. Invalid lengths close the session.
+ */
+#pragma once
+
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "Message.h"
+
+namespace asio = boost::asio;
+
+namespace asioclient {
+namespace bench {
+
+/**
+ * @class EchoSession
+ * @brief One accepted connection; reads ahead and echoes whole frames
+ */
+class EchoSession : public std::enable_shared_from_this<EchoSession> {
+public:
+    explicit EchoSession(asio::ip::tcp::socket socket)
+        : socket_(std::move(socket)), readBuffer_(64 * 1024) {}
+
+    void start() {
+        asio::ip::tcp::no_delay noDelay(true);
+        boost::system::error_code ec;
+        socket_.set_option(noDelay, ec);
+        doRead();
+    }
+
+private:
+    void doRead() {
+        auto self = shared_from_this();
+
+        // Grow to hold the frame currently being received
+        size_t required = readBuffer_.size();
+        if (readEnd_ >= HEADER_SIZE) {
+            required = std::max(required, HEADER_SIZE + Message::decodeHeader(readBuffer_.data()));
+        }
+        if (readBuffer_.size() < required) {
+            readBuffer_.resize(required);
+        }
+
+        socket_.async_read_some(
+            asio::buffer(readBuffer_.data() + readEnd_, readBuffer_.size() - readEnd_),
+            [this, self](const boost::system::error_code& ec, std::size_t length) {
+                if (ec) {
+                    return;
+                }
+                readEnd_ += length;
+                if (echoFrames()) {
+                    doRead();
+                }
+            });
+    }
+
+    bool echoFrames() {
+        size_t complete = 0;
+        while (readEnd_ - complete >= HEADER_SIZE) {
+            uint32_t bodyLen = Message::decodeHeader(readBuffer_.data() + complete);
+            if (!Message::isValidLength(bodyLen)) {
+                boost::system::error_code ignored;
+                socket_.close(ignored);
+                return false;
+            }
+            if (readEnd_ - complete < HEADER_SIZE + bodyLen) {
+                break;
+            }
+            complete += HEADER_SIZE + bodyLen;
+        }
+
+        if (complete > 0) {
+            pending_.insert(pending_.end(), readBuffer_.data(), readBuffer_.data() + complete);
+            std::memmove(readBuffer_.data(), readBuffer_.data() + complete, readEnd_ - complete);
+            readEnd_ -= complete;
+            if (!writing_) {
+                doWrite();
+            }
+        }
+        return true;
+    }
+
+    void doWrite() {
+        auto self = shared_from_this();
+        writing_ = true;
+        inFlight_.swap(pending_);
+        pending_.clear();
+
+        asio::async_write(
+            socket_,
+            asio::buffer(inFlight_),
+            [this, self](const boost::system::error_code& ec, std::size_t /*length*/) {
+                writing_ = false;
+                if (ec) {
+                    return;
+                }
+                if (!pending_.empty()) {
+                    doWrite();
+                }
+            });
+    }
+
+    asio::ip::tcp::socket socket_;
+    std::vector<char> readBuffer_;
+    size_t readEnd_{0};
+    std::vector<char> pending_;   // Frames waiting for the next write
+    std::vector<char> inFlight_;  // Frames of the write in progress
+    bool writing_{false};
+};
+
+/**
+ * @class EchoServer
+ * @brief Listens on 127.0.0.1 and runs its own io_context threads
+ */
+class EchoServer {
+public:
+    /**
+     * @param threads Threads running the server io_context
+     * @param port Listening port (0 = ephemeral, see port())
+     */
+    explicit EchoServer(size_t threads = 1, uint16_t port = 0)
+        : acceptor_(ioContext_, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port))
+        , workGuard_(asio::make_work_guard(ioContext_))
+    {
+        doAccept();
+        for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i) {
+            threads_.emplace_back([this]() { ioContext_.run(); });
+        }
+    }
+
+    ~EchoServer() {
+        ioContext_.stop();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    // Non-copyable
+    EchoServer(const EchoServer&) = delete;
+    EchoServer& operator=(const EchoServer&) = delete;
+
+    uint16_t port() const { return acceptor_.local_endpoint().port(); }
+
+private:
+    void doAccept() {
+        // Each session gets its own strand so the server can run on many threads
+        acceptor_.async_accept(
+            asio::make_strand(ioContext_),
+            [this](const boost::system::error_code& ec, asio::ip::tcp::socket socket) {
+                if (!ec) {
+                    std::make_shared<EchoSession>(std::move(socket))->start();
+                }
+                if (acceptor_.is_open()) {
+                    doAccept();
+                }
+            });
+    }
+
+    asio::io_context ioContext_;
+    asio::ip::tcp::acceptor acceptor_;
+    asio::executor_work_guard<asio::io_context::executor_type> workGuard_;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace bench
+} // namespace asioclient
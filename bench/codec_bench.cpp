@@ -0,0 +1,124 @@
+/**
+ * @file codec_bench.cpp
+ * @brief Google Benchmark microbenchmarks for the Message framing codec
+ *
+ * Covers Message::encode() / decodeHeader() across payload sizes, encode()
+ * versus in-place header serialization (the send path), and parsing a
+ * buffer of many concatenated frames (the read-ahead receive path).
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+#include "Message.h"
+
+using namespace asioclient;
+
+namespace {
+
+std::vector<char> makeFrames(size_t bodySize, size_t frameCount) {
+    std::vector<char> buffer;
+    buffer.reserve(frameCount * (HEADER_SIZE + bodySize));
+    Message msg(std::vector<char>(bodySize, 'x'));
+    for (size_t i = 0; i < frameCount; ++i) {
+        std::vector<char> frame = msg.encode();
+        buffer.insert(buffer.end(), frame.begin(), frame.end());
+    }
+    return buffer;
+}
+
+// Per-size arguments: 0B (heartbeat-sized) up to 1MB
+void payloadSizes(benchmark::internal::Benchmark* b) {
+    for (int64_t size : {0, 16, 64, 256, 1024, 4096, 16384, 65536, 1 << 20}) {
+        b->Arg(size);
+    }
+}
+
+} // namespace
+
+// Message::encode(): allocates and copies header + body
+static void BM_Encode(benchmark::State& state) {
+    Message msg(std::vector<char>(static_cast<size_t>(state.range(0)), 'x'));
+    for (auto _ : state) {
+        std::vector<char> frame = msg.encode();
+        benchmark::DoNotOptimize(frame.data());
+    }
+    state.SetBytesProcessed(state.iterations() * (HEADER_SIZE + state.range(0)));
+}
+BENCHMARK(BM_Encode)->Apply(payloadSizes);
+
+// Send path: header serialized into a fixed array, body referenced as is
+static void BM_EncodeHeaderInPlace(benchmark::State& state) {
+    Message msg(std::vector<char>(static_cast<size_t>(state.range(0)), 'x'));
+    char header[HEADER_SIZE];
+    for (auto _ : state) {
+        Message::encodeHeader(static_cast<uint32_t>(msg.bodySize()), header);
+        benchmark::DoNotOptimize(header);
+        benchmark::DoNotOptimize(msg.data());
+    }
+    state.SetBytesProcessed(state.iterations() * (HEADER_SIZE + state.range(0)));
+}
+BENCHMARK(BM_EncodeHeaderInPlace)->Apply(payloadSizes);
+
+static void BM_DecodeHeader(benchmark::State& state) {
+    char header[HEADER_SIZE];
+    Message::encodeHeader(12345, header);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(header);
+        uint32_t len = Message::decodeHeader(header);
+        benchmark::DoNotOptimize(len);
+    }
+}
+BENCHMARK(BM_DecodeHeader);
+
+// Full decode into an owning Message, as the non-view receive path does
+static void BM_Decode(benchmark::State& state) {
+    std::vector<char> frame = makeFrames(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        uint32_t len = Message::decodeHeader(frame.data());
+        if (!Message::isValidLength(len)) {
+            state.SkipWithError("invalid length");
+            break;
+        }
+        Message msg;
+        msg.setBody(frame.data() + HEADER_SIZE, len);
+        benchmark::DoNotOptimize(msg.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(frame.size()));
+}
+BENCHMARK(BM_Decode)->Apply(payloadSizes);
+
+// Walk a read-ahead buffer of concatenated frames the way
+// TcpClient::parseFrames() does, yielding a MessageView per frame
+static void BM_ParseFrames(benchmark::State& state) {
+    const size_t bodySize = static_cast<size_t>(state.range(0));
+    const size_t frameCount = static_cast<size_t>(state.range(1));
+    std::vector<char> buffer = makeFrames(bodySize, frameCount);
+
+    for (auto _ : state) {
+        size_t start = 0;
+        size_t end = buffer.size();
+        size_t frames = 0;
+        while (end - start >= HEADER_SIZE) {
+            uint32_t len = Message::decodeHeader(buffer.data() + start);
+            if (!Message::isValidLength(len) || end - start < HEADER_SIZE + len) {
+                break;
+            }
+            MessageView view(buffer.data() + start + HEADER_SIZE, len);
+            benchmark::DoNotOptimize(view.data());
+            start += HEADER_SIZE + len;
+            ++frames;
+        }
+        benchmark::DoNotOptimize(frames);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frameCount));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_ParseFrames)
+    ->Args({16, 4096})
+    ->Args({64, 1024})
+    ->Args({256, 256})
+    ->Args({1024, 64})
+    ->Args({4096, 16});
+
+BENCHMARK_MAIN();
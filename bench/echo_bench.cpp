@@ -0,0 +1,341 @@
+/**
+ * @file echo_bench.cpp
+ * @brief Loopback throughput / latency harness for TcpClient
+ *
+ * Starts an embedded EchoServer and, for every combination of message size,
+ * connection count and io_context thread count, keeps a window of messages
+ * in flight on each connection for a fixed duration. Each payload carries its
+ * send timestamp, so the echo gives the round-trip time.
+ *
+ * Usage:
+ *   echo_bench [--sizes 16,1024,65536] [--connections 1,8] [--threads 1,4]
+ *              [--duration-ms 2000] [--window 0] [--batching] [--read-ahead]
+ *              [--view] [--batch] [--cork-us 200]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TcpClient.h"
+#include "ClientStats.h"
+#include "EchoServer.h"
+
+using namespace asioclient;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchOptions {
+    std::vector<size_t> sizes{16, 256, 4096, 65536, 1024 * 1024, 16 * 1024 * 1024};
+    std::vector<size_t> connections{1, 8};
+    std::vector<size_t> threads{1, 4};
+    std::chrono::milliseconds duration{2000};
+    size_t window = 0;          // Messages in flight per connection (0 = by size)
+    bool batching = false;
+    bool readAhead = false;
+    bool view = false;          // Receive through setOnMessageView
+    bool batch = false;         // Receive through setOnMessageBatch
+    long corkUs = -1;           // WriteConfig::corkDelay in microseconds (-1 = cork off)
+};
+
+struct BenchResult {
+    bool connected = false;     // Every connection came up before the deadline
+    uint64_t messages = 0;
+    double seconds = 0;
+    HistogramSnapshot rtt;
+};
+
+std::vector<size_t> parseList(const std::string& text) {
+    std::vector<size_t> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            values.push_back(static_cast<size_t>(std::strtoull(item.c_str(), nullptr, 10)));
+        }
+    }
+    return values;
+}
+
+bool parseOptions(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string { return i + 1 < argc ? argv[++i] : ""; };
+
+        if (arg == "--sizes") {
+            options.sizes = parseList(next());
+        } else if (arg == "--connections") {
+            options.connections = parseList(next());
+        } else if (arg == "--threads") {
+            options.threads = parseList(next());
+        } else if (arg == "--duration-ms") {
+            options.duration = std::chrono::milliseconds(std::atoll(next().c_str()));
+        } else if (arg == "--window") {
+            options.window = static_cast<size_t>(std::atoll(next().c_str()));
+        } else if (arg == "--batching") {
+            options.batching = true;
+        } else if (arg == "--read-ahead") {
+            options.readAhead = true;
+        } else if (arg == "--view") {
+            options.view = true;
+        } else if (arg == "--batch") {
+            options.batch = true;
+        } else if (arg == "--cork-us") {
+            options.corkUs = std::atol(next().c_str());
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    auto positive = [](const std::vector<size_t>& values) {
+        return !values.empty() &&
+               std::find(values.begin(), values.end(), size_t(0)) == values.end();
+    };
+    if (options.sizes.empty()) {
+        std::cerr << "--sizes needs at least one value" << std::endl;
+        return false;
+    }
+    if (!positive(options.connections) || !positive(options.threads)) {
+        std::cerr << "--connections and --threads need at least one value, none of them 0"
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief One benchmark connection: refills its window on every echo
+ */
+class BenchConnection {
+public:
+    BenchConnection(asio::io_context& ioContext, const BenchOptions& options, size_t size,
+                    std::atomic<bool>& running, LogHistogram& rtt, std::atomic<uint64_t>& completed)
+        : client_(createClient(ioContext))
+        , size_(std::max<size_t>(size, sizeof(int64_t)))
+        , running_(running)
+        , rtt_(rtt)
+        , completed_(completed)
+    {
+        WriteConfig writeConfig;
+        writeConfig.batching = options.batching;
+        if (options.corkUs >= 0) {
+            writeConfig.cork = true;
+            writeConfig.corkDelay = std::chrono::microseconds(options.corkUs);
+        }
+        client_->setWriteConfig(writeConfig);
+
+        ReadConfig readConfig;
+        readConfig.readAhead = options.readAhead;
+        client_->setReadConfig(readConfig);
+
+        ReconnectConfig reconnectConfig;
+        reconnectConfig.enabled = false;
+        client_->setReconnectConfig(reconnectConfig);
+
+        if (options.batch) {
+            client_->setOnMessageBatch([this](const MessageBatch& batch) {
+                for (const auto& view : batch) {
+                    onEcho(view.data(), view.bodySize());
+                }
+            });
+        } else if (options.view) {
+            client_->setOnMessageView([this](const MessageView& view) {
+                onEcho(view.data(), view.bodySize());
+            });
+        } else {
+            client_->setOnMessage([this](Message& msg) {
+                onEcho(msg.data(), msg.bodySize());
+            });
+        }
+        client_->setOnError([this](const boost::system::error_code& ec) {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "[bench] client error: " << ec.message() << std::endl;
+        });
+    }
+
+    const TcpClientPtr& client() const { return client_; }
+
+    void start(size_t window) {
+        for (size_t i = 0; i < window; ++i) {
+            sendOne();
+        }
+    }
+
+    size_t inFlight() const { return inFlight_.load(std::memory_order_relaxed); }
+    size_t errors() const { return errors_.load(std::memory_order_relaxed); }
+
+private:
+    void sendOne() {
+        std::vector<char> body(size_);
+        int64_t now = Clock::now().time_since_epoch().count();
+        std::memcpy(body.data(), &now, sizeof(now));
+        inFlight_.fetch_add(1, std::memory_order_relaxed);
+        client_->send(Message(std::move(body)));
+    }
+
+    void onEcho(const char* data, size_t len) {
+        inFlight_.fetch_sub(1, std::memory_order_relaxed);
+        if (len < sizeof(int64_t)) {
+            return;
+        }
+
+        int64_t sentAt;
+        std::memcpy(&sentAt, data, sizeof(sentAt));
+        int64_t now = Clock::now().time_since_epoch().count();
+        Clock::duration elapsed(now - sentAt);
+        rtt_.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+
+        if (running_.load(std::memory_order_relaxed)) {
+            completed_.fetch_add(1, std::memory_order_relaxed);
+            sendOne();
+        }
+    }
+
+    TcpClientPtr client_;
+    size_t size_;
+    std::atomic<bool>& running_;
+    LogHistogram& rtt_;
+    std::atomic<uint64_t>& completed_;
+    std::atomic<size_t> inFlight_{0};
+    std::atomic<size_t> errors_{0};
+};
+
+size_t defaultWindow(size_t size) {
+    // Keep about 4MB in flight per connection, between 1 and 64 messages
+    return std::min<size_t>(64, std::max<size_t>(1, (4 * 1024 * 1024) / std::max<size_t>(size, 1)));
+}
+
+BenchResult runOne(const BenchOptions& options, uint16_t port,
+                   size_t size, size_t connections, size_t threads) {
+    asio::io_context ioContext;
+    auto workGuard = asio::make_work_guard(ioContext);
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> completed{0};
+    auto rtt = std::make_unique<LogHistogram>();
+
+    std::vector<std::unique_ptr<BenchConnection>> conns;
+    std::atomic<size_t> connected{0};
+    for (size_t i = 0; i < connections; ++i) {
+        conns.push_back(std::make_unique<BenchConnection>(
+            ioContext, options, size, running, *rtt, completed));
+        conns.back()->client()->setOnConnected([&connected]() { ++connected; });
+        conns.back()->client()->connect("127.0.0.1", port);
+    }
+
+    std::vector<std::thread> ioThreads;
+    for (size_t i = 0; i < threads; ++i) {
+        ioThreads.emplace_back([&ioContext]() { ioContext.run(); });
+    }
+
+    // Reconnect is off, so a connection that reported an error never comes up
+    auto connectDeadline = Clock::now() + std::chrono::seconds(10);
+    auto failed = [&conns]() {
+        return std::any_of(conns.begin(), conns.end(),
+                           [](const auto& conn) { return conn->errors() > 0; });
+    };
+    while (connected.load() < connections && !failed() && Clock::now() < connectDeadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    BenchResult result;
+    result.connected = connected.load() == connections;
+
+    size_t window = options.window ? options.window : defaultWindow(size);
+    auto startedAt = Clock::now();
+    if (result.connected) {
+        for (auto& conn : conns) {
+            conn->start(window);
+        }
+        std::this_thread::sleep_for(options.duration);
+        running = false;
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - startedAt).count();
+    uint64_t messages = completed.load();
+
+    // Let the in-flight tail come back before tearing down
+    auto drainDeadline = Clock::now() + std::chrono::seconds(10);
+    for (auto& conn : conns) {
+        while (conn->inFlight() > 0 && Clock::now() < drainDeadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        conn->client()->disconnect();
+    }
+
+    workGuard.reset();
+    ioContext.stop();
+    for (auto& thread : ioThreads) {
+        thread.join();
+    }
+
+    result.messages = messages;
+    result.seconds = seconds;
+    result.rtt = rtt->snapshot();
+    return result;
+}
+
+std::string formatSize(size_t size) {
+    if (size >= 1024 * 1024 && size % (1024 * 1024) == 0) {
+        return std::to_string(size / (1024 * 1024)) + "MB";
+    }
+    if (size >= 1024 && size % 1024 == 0) {
+        return std::to_string(size / 1024) + "KB";
+    }
+    return std::to_string(size) + "B";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    size_t serverThreads = *std::max_element(options.threads.begin(), options.threads.end());
+    bench::EchoServer server(serverThreads);
+
+    std::cout << "=== AsioTcpClient echo benchmark ===" << std::endl;
+    std::cout << "batching=" << options.batching << " read-ahead=" << options.readAhead
+              << " view=" << options.view << " batch=" << options.batch << " cork-us=" << options.corkUs << " duration=" << options.duration.count() << "ms"
+              << std::endl << std::endl;
+
+    std::printf("%8s %6s %8s %12s %10s %10s %10s %10s\n",
+                "size", "conns", "threads", "msgs/s", "MB/s", "p50(us)", "p99(us)", "p999(us)");
+
+    for (size_t size : options.sizes) {
+        for (size_t connections : options.connections) {
+            for (size_t threads : options.threads) {
+                BenchResult r = runOne(options, server.port(), size, connections, threads);
+                if (!r.connected) {
+                    std::printf("%8s %6zu %8zu  connect failed\n",
+                                formatSize(size).c_str(), connections, threads);
+                    std::fflush(stdout);
+                    continue;
+                }
+                double rate = r.seconds > 0 ? r.messages / r.seconds : 0;
+                double mbps = rate * static_cast<double>(size) / (1024.0 * 1024.0);
+
+                std::printf("%8s %6zu %8zu %12.0f %10.1f %10.1f %10.1f %10.1f\n",
+                            formatSize(size).c_str(), connections, threads, rate, mbps,
+                            r.rtt.percentile(0.50) / 1000.0,
+                            r.rtt.percentile(0.99) / 1000.0,
+                            r.rtt.percentile(0.999) / 1000.0);
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    return 0;
+}
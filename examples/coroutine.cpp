@@ -0,0 +1,62 @@
+/**
+ * @file coroutine.cpp
+ * @brief C++20 coroutine usage example (request / response loop)
+ */
+
+#include <iostream>
+#include <string>
+#include "TcpClient.h"
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+using namespace asioclient;
+
+asio::awaitable<void> run(TcpClientPtr client, std::string host, uint16_t port) {
+    try {
+        co_await client->asyncConnect(host, port);
+        std::cout << "[Connected] " << host << ":" << port << std::endl;
+
+        for (int i = 0; i < 5; ++i) {
+            size_t written = co_await client->asyncSend(Message("Hello #" + std::to_string(i)));
+            Message reply = co_await client->asyncReceive();
+            std::cout << "[Message] " << written << " bytes sent, received: "
+                      << reply.bodyAsString() << std::endl;
+        }
+    } catch (const boost::system::system_error& e) {
+        std::cout << "[Error] " << e.code().message() << std::endl;
+    }
+
+    client->disconnect();
+}
+
+int main(int argc, char* argv[]) {
+    std::string host = "127.0.0.1";
+    uint16_t port = 10086;
+
+    if (argc >= 2) {
+        host = argv[1];
+    }
+    if (argc >= 3) {
+        port = static_cast<uint16_t>(std::atoi(argv[2]));
+    }
+
+    asio::io_context ioContext;
+    auto client = createClient(ioContext);
+
+    ReconnectConfig config;
+    config.enabled = false;
+    client->setReconnectConfig(config);
+
+    asio::co_spawn(ioContext, run(client, host, port), asio::detached);
+    ioContext.run();
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "This example requires C++20 coroutines (-DASIOCLIENT_CXX20=ON)" << std::endl;
+    return 0;
+}
+
+#endif
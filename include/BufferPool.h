@@ -0,0 +1,97 @@
+/**
+ * @file BufferPool.h
+ * @brief Size-class buffer pool for recycling message bodies
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace asioclient {
+
+/**
+ * @struct BufferPoolConfig
+ * @brief Buffer pool configuration
+ *
+ * Buffers are grouped in power-of-two size classes between minBufferSize and
+ * maxBufferSize; larger requests bypass the pool.
+ */
+struct BufferPoolConfig {
+    bool enabled = true;
+    size_t minBufferSize = 256;            // Smallest size class: 256B
+    size_t maxBufferSize = 1024 * 1024;    // Largest size class: 1MB
+    size_t maxBuffersPerClass = 32;        // Free buffers kept per size class
+    size_t maxBytesHeld = 4 * 1024 * 1024; // Upper bound of memory held by the pool: 4MB
+};
+
+/**
+ * @struct BufferPoolStats
+ * @brief Snapshot of buffer pool counters
+ */
+struct BufferPoolStats {
+    uint64_t hits = 0;          // Acquires served from a free list
+    uint64_t misses = 0;        // Acquires that had to allocate
+    uint64_t recycled = 0;      // Releases kept for reuse
+    uint64_t discarded = 0;     // Releases freed (pool full or buffer out of range)
+    size_t buffersHeld = 0;     // Free buffers currently held
+    size_t bytesHeld = 0;       // Capacity of free buffers currently held
+};
+
+/**
+ * @class BufferPool
+ * @brief Free lists of std::vector<char> buffers by size class
+ *
+ * acquire()/release() must be called from one thread at a time (the client's
+ * IO thread); stats() may be called from any thread.
+ */
+class BufferPool {
+public:
+    explicit BufferPool(const BufferPoolConfig& config = BufferPoolConfig());
+
+    // Non-copyable
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Reconfigure the pool, dropping all free buffers
+     */
+    void configure(const BufferPoolConfig& config);
+    const BufferPoolConfig& config() const { return config_; }
+
+    /**
+     * @brief Get a buffer of exactly `size` bytes
+     * @return Buffer whose capacity is rounded up to its size class
+     */
+    std::vector<char> acquire(size_t size);
+
+    /**
+     * @brief Return a buffer to its size class (freed if the pool is full)
+     */
+    void release(std::vector<char>&& buffer);
+
+    /**
+     * @brief Free all held buffers
+     */
+    void clear();
+
+    BufferPoolStats stats() const;
+
+private:
+    static size_t roundUpPow2(size_t size);
+    size_t classOf(size_t capacity) const;
+
+    BufferPoolConfig config_;
+    std::vector<std::vector<std::vector<char>>> freeLists_;  // One free list per size class
+
+    // Counters (relaxed atomics so stats() can be read from other threads)
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> recycled_{0};
+    std::atomic<uint64_t> discarded_{0};
+    std::atomic<size_t> buffersHeld_{0};
+    std::atomic<size_t> bytesHeld_{0};
+};
+
+} // namespace asioclient
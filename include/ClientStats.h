@@ -0,0 +1,196 @@
+/**
+ * @file ClientStats.h
+ * @brief Lock-free per-client counters and log-bucket histograms
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace asioclient {
+
+/**
+ * @struct HistogramSnapshot
+ * @brief Point-in-time copy of a LogHistogram
+ */
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+    std::vector<uint64_t> buckets;  // Indexed like LogHistogram::bucketOf()
+
+    double mean() const { return count ? static_cast<double>(sum) / count : 0.0; }
+
+    /**
+     * @brief Value at the given quantile (0.0 - 1.0), upper bound of its bucket
+     */
+    uint64_t percentile(double quantile) const;
+};
+
+/**
+ * @class LogHistogram
+ * @brief HDR-style log-linear histogram with relaxed atomic buckets
+ *
+ * Each power of two is split into 8 linear sub-buckets, so any recorded
+ * value is reported within 12.5%. record() is wait-free and safe from any
+ * thread.
+ */
+class LogHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 3;
+    static constexpr size_t kSubBuckets = size_t(1) << kSubBucketBits;
+    static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    void record(uint64_t value) {
+        buckets_[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t current = max_.load(std::memory_order_relaxed);
+        while (value > current &&
+               !max_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    HistogramSnapshot snapshot() const;
+
+    static size_t bucketOf(uint64_t value) {
+        if (value < kSubBuckets) {
+            return static_cast<size_t>(value);
+        }
+        unsigned msb = 63 - countLeadingZeros(value);
+        unsigned shift = msb - kSubBucketBits;
+        return (static_cast<size_t>(shift + 1) << kSubBucketBits) +
+               static_cast<size_t>((value >> shift) & (kSubBuckets - 1));
+    }
+
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    static unsigned countLeadingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned n = 0;
+        for (uint64_t bit = uint64_t(1) << 63; !(value & bit); bit >>= 1) {
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * @struct StatsConfig
+ * @brief Instrumentation configuration
+ */
+struct StatsConfig {
+    bool enabled = true;                        // Counters and histograms (a few relaxed atomics per op)
+    std::chrono::milliseconds reportInterval{0};  // Period of the stats callback (0 = off)
+};
+
+/**
+ * @struct ClientStats
+ * @brief Snapshot of TcpClient counters; latencies are in nanoseconds
+ */
+struct ClientStats {
+    // Traffic
+    uint64_t bytesIn = 0;           // Bytes read from the socket (headers included)
+    uint64_t bytesOut = 0;          // Bytes written to the socket (headers included)
+    uint64_t messagesIn = 0;
+    uint64_t messagesOut = 0;
+    uint64_t messagesRejected = 0;  // BackpressurePolicy::Reject, or too large for the framing
+    uint64_t messagesDropped = 0;   // BackpressurePolicy::DropOldest, ReplayPolicy::Drop
+    uint64_t messagesReplayed = 0;  // Resent on a new connection
+    uint64_t messagesSpilled = 0;   // Written to the spill file
+    uint64_t heartbeatsIn = 0;      // Zero-length frames received (counted in messagesIn too)
+    uint64_t heartbeatsOut = 0;     // Heartbeats queued (written ones count in messagesOut too)
+    uint64_t zeroCopySends = 0;     // Frames written with MSG_ZEROCOPY
+    uint64_t zeroCopyCopied = 0;    // Completions where the kernel copied anyway (e.g. loopback)
+    uint64_t filesSent = 0;         // sendFile() frames written
+    uint64_t pacedWrites = 0;       // Writes held back by PacingConfig until their tokens accrued
+
+    // Connection lifecycle
+    uint64_t connects = 0;          // Successful connects
+    uint64_t connectFailures = 0;
+    uint64_t reconnects = 0;        // Reconnect attempts started
+    uint64_t disconnects = 0;       // Established connections lost or closed
+    uint64_t tlsHandshakes = 0;     // Completed TLS handshakes
+    uint64_t tlsResumptions = 0;    // ...of which resumed a cached session
+
+    // Current write queue
+    size_t queuedBytes = 0;
+    size_t queuedMessages = 0;
+
+    // Distributions
+    HistogramSnapshot writeBatchMessages;  // Frames per async_write
+    HistogramSnapshot writeBatchBytes;     // Bytes per async_write
+    HistogramSnapshot queueDepth;          // Queued frames seen by send()
+    HistogramSnapshot sendLatency;         // send() to write completion
+    HistogramSnapshot dispatchLatency;     // Outbox wakeup post to handler run
+    HistogramSnapshot connectDuration;     // Resolve start to connected
+};
+
+/**
+ * @class StatsCounters
+ * @brief Live counters behind TcpClient::stats()
+ *
+ * Counters updated by producer threads are kept on their own cache line,
+ * away from the ones updated by the IO thread.
+ */
+class StatsCounters {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static uint64_t elapsedNs(Clock::time_point since) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - since).count());
+    }
+
+    static void add(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+        counter.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    ClientStats snapshot() const;
+
+    // Producer side
+    alignas(64) std::atomic<uint64_t> messagesRejected{0};
+    LogHistogram queueDepth;
+
+    // IO thread side
+    alignas(64) std::atomic<uint64_t> bytesIn{0};
+    std::atomic<uint64_t> bytesOut{0};
+    std::atomic<uint64_t> messagesIn{0};
+    std::atomic<uint64_t> messagesOut{0};
+    std::atomic<uint64_t> messagesDropped{0};
+    std::atomic<uint64_t> messagesReplayed{0};
+    std::atomic<uint64_t> messagesSpilled{0};
+    std::atomic<uint64_t> heartbeatsIn{0};
+    std::atomic<uint64_t> heartbeatsOut{0};
+    std::atomic<uint64_t> zeroCopySends{0};
+    std::atomic<uint64_t> zeroCopyCopied{0};
+    std::atomic<uint64_t> filesSent{0};
+    std::atomic<uint64_t> pacedWrites{0};
+    std::atomic<uint64_t> connects{0};
+    std::atomic<uint64_t> connectFailures{0};
+    std::atomic<uint64_t> reconnects{0};
+    std::atomic<uint64_t> disconnects{0};
+    std::atomic<uint64_t> tlsHandshakes{0};
+    std::atomic<uint64_t> tlsResumptions{0};
+    LogHistogram writeBatchMessages;
+    LogHistogram writeBatchBytes;
+    LogHistogram sendLatency;
+    LogHistogram dispatchLatency;
+    LogHistogram connectDuration;
+};
+
+} // namespace asioclient
@@ -0,0 +1,38 @@
+/**
+ * @file Completion.h
+ * @brief Type erasure for Asio completion handlers
+ */
+#pragma once
+
+#include <boost/asio.hpp>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+namespace asioclient {
+
+namespace asio = boost::asio;
+
+/**
+ * @brief Wrap a completion handler into a std::function that invokes it on
+ *        its associated executor, keeping that executor busy until then
+ *
+ * The handler may be move-only, hence the shared_ptr; call the result once.
+ * @param handler Completion handler produced by async_initiate
+ * @param fallback Executor used when the handler has none associated
+ */
+template <typename... Args, typename Handler, typename Executor>
+std::function<void(Args...)> bindCompletion(Handler handler, const Executor& fallback) {
+    auto work = asio::make_work_guard(asio::get_associated_executor(handler, fallback));
+    auto shared = std::make_shared<Handler>(std::move(handler));
+    return [shared, work](Args... args) mutable {
+        asio::post(work.get_executor(),
+                   [shared, args = std::make_tuple(std::move(args)...)]() mutable {
+                       std::apply(std::move(*shared), std::move(args));
+                   });
+        work.reset();
+    };
+}
+
+} // namespace asioclient
@@ -0,0 +1,96 @@
+/**
+ * @file Compression.h
+ * @brief Optional per-frame compression (LZ4 / zstd)
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace asioclient {
+
+/**
+ * @enum CompressionCodec
+ * @brief Codec of a compressed body; the value is the envelope's codec byte
+ */
+enum class CompressionCodec : uint8_t {
+    None = 0,
+    Lz4 = 1,   // Fast, for latency-sensitive links (ASIOCLIENT_HAS_LZ4)
+    Zstd = 2   // Better ratio, for WAN bandwidth (ASIOCLIENT_HAS_ZSTD)
+};
+
+/**
+ * @struct CompressionConfig
+ * @brief Compression of outgoing frames and acceptance of incoming ones
+ *
+ * With codec None (the default) a header with COMPRESSED_FLAG set is an
+ * invalid length and disconnects with message_size; otherwise incoming
+ * compressed frames are decoded with whatever codec they name. Both ends have to agree out of band: plain frames stay byte-identical, but
+ * a peer that does not know the COMPRESSED_FLAG header bit rejects compressed
+ * ones. Frames that do not get smaller are sent as they are.
+ */
+struct CompressionConfig {
+    CompressionCodec codec = CompressionCodec::None;
+    size_t threshold = 1024;  // Bodies smaller than this are sent uncompressed: 1KB
+    int level = 0;            // zstd level / LZ4 acceleration (0 = library default)
+};
+
+// Whether this build was linked with the codec
+bool compressionAvailable(CompressionCodec codec);
+
+constexpr size_t COMPRESSION_HEADER_SIZE = 5;  // [Codec (1B)][Original length (4B)]
+
+/**
+ * @class FrameCodec
+ * @brief Per-connection compression contexts, reused for every frame
+ *
+ * Not thread-safe: owned by one client and used on its strand only. Output
+ * buffers are supplied by the caller (the client's BufferPool), so no frame
+ * allocates inside the codec.
+ */
+class FrameCodec {
+public:
+    FrameCodec();
+    ~FrameCodec();
+
+    // Non-copyable
+    FrameCodec(const FrameCodec&) = delete;
+    FrameCodec& operator=(const FrameCodec&) = delete;
+
+    void configure(const CompressionConfig& config);
+    const CompressionConfig& config() const { return config_; }
+
+    // Whether a body of this size should be compressed
+    bool wants(size_t size) const {
+        return config_.codec != CompressionCodec::None && size > 0 && size >= config_.threshold;
+    }
+
+    /**
+     * @brief Compress into out, which must hold `size` bytes
+     * @return false if the codec is unavailable or the envelope would not be
+     *         smaller than the input; on success out is resized to the envelope
+     */
+    bool compress(const char* data, size_t size, std::vector<char>& out);
+
+    /**
+     * @brief Original body length of an envelope
+     * @return false if the envelope is malformed or larger than MAX_BODY_SIZE
+     */
+    static bool originalSize(const char* data, size_t size, uint32_t& original);
+
+    /**
+     * @brief Decompress an envelope into out, exactly originalSize() bytes
+     * @return false on an unavailable codec or corrupt data
+     */
+    bool decompress(const char* data, size_t size, char* out, size_t original);
+
+private:
+    struct Contexts;
+
+    CompressionConfig config_;
+    std::unique_ptr<Contexts> contexts_;  // Created on first use per codec
+};
+
+} // namespace asioclient
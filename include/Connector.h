@@ -0,0 +1,117 @@
+/**
+ * @file Connector.h
+ * @brief Connection establishment over a list of resolved endpoints
+ */
+#pragma once
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace asio = boost::asio;
+
+namespace asioclient {
+
+/**
+ * @enum ConnectStrategy
+ * @brief How the resolved endpoints are tried
+ */
+enum class ConnectStrategy {
+    Sequential,     // One endpoint at a time, next one after failure or timeout
+    HappyEyeballs   // RFC 8305: staggered parallel attempts, families interleaved
+};
+
+/**
+ * @struct ConnectConfig
+ * @brief Connection establishment configuration
+ */
+struct ConnectConfig {
+    ConnectStrategy strategy = ConnectStrategy::Sequential;
+    std::chrono::milliseconds attemptTimeout{10000};  // Per-endpoint timeout: 10s (0 = OS default)
+    std::chrono::milliseconds attemptDelay{250};      // HappyEyeballs: delay before the next parallel attempt
+    std::chrono::milliseconds handshakeTimeout{10000}; // TLS handshake after TCP connect: 10s (0 = none)
+};
+
+/**
+ * @struct SocketConfig
+ * @brief Kernel socket tuning, applied to every new socket (so on every reconnect)
+ *
+ * Buffer sizes are set by the Connector before connecting, so the receive
+ * buffer also shapes the window scale offered in the SYN; the rest are set
+ * once connected. Options the platform lacks are skipped (Linux has them all).
+ * TCP_QUICKACK is not sticky on Linux and is re-armed after every read.
+ */
+struct SocketConfig {
+    int sendBufferSize = 0;                      // SO_SNDBUF bytes (0 = OS default)
+    int receiveBufferSize = 0;                   // SO_RCVBUF bytes (0 = OS default)
+    bool quickAck = false;                       // TCP_QUICKACK: ack immediately, no delayed ACK
+    std::chrono::microseconds busyPoll{0};       // SO_BUSY_POLL: spin on the NIC queue before sleeping (0 = off)
+    std::chrono::milliseconds userTimeout{0};    // TCP_USER_TIMEOUT: unacked data drops the connection (0 = OS default)
+};
+
+/**
+ * @class Connector
+ * @brief Single-use connect operation used by TcpClient
+ *
+ * Starts attempts on the endpoint list according to ConnectConfig. The first
+ * socket to connect wins; every other attempt is cancelled. All handlers run
+ * on the executor passed to the constructor (the client's strand).
+ */
+class Connector : public std::enable_shared_from_this<Connector> {
+public:
+    using Handler = std::function<void(const boost::system::error_code&)>;
+
+    Connector(const asio::any_io_executor& executor, const ConnectConfig& config,
+              const SocketConfig& socketConfig = SocketConfig());
+
+    // Non-copyable
+    Connector(const Connector&) = delete;
+    Connector& operator=(const Connector&) = delete;
+
+    /**
+     * @brief Start connecting; handler is called exactly once unless cancelled
+     * @param handler Receives success or the error of the last failed attempt
+     */
+    void start(const asio::ip::tcp::resolver::results_type& endpoints, Handler handler);
+
+    /**
+     * @brief The connected socket (after a successful handler call), to be moved from
+     */
+    asio::ip::tcp::socket& socket() { return attempts_[winner_]->socket; }
+
+    /**
+     * @brief Abort all attempts without calling the handler
+     */
+    void cancel();
+
+private:
+    struct Attempt {
+        explicit Attempt(const asio::any_io_executor& executor)
+            : socket(executor), timer(executor) {}
+
+        asio::ip::tcp::socket socket;
+        asio::steady_timer timer;
+        bool timedOut = false;
+    };
+
+    void startNext();
+    void onAttemptDone(size_t index, const boost::system::error_code& ec);
+    void finish();
+
+    asio::any_io_executor executor_;
+    ConnectConfig config_;
+    SocketConfig socketConfig_;
+    Handler handler_;
+
+    std::vector<asio::ip::tcp::endpoint> endpoints_;  // In attempt order
+    std::vector<std::unique_ptr<Attempt>> attempts_;
+    asio::steady_timer delayTimer_;                   // Staggers HappyEyeballs attempts
+    size_t active_{0};
+    size_t winner_{0};
+    bool finished_{false};
+    boost::system::error_code lastError_;
+};
+
+} // namespace asioclient
@@ -0,0 +1,151 @@
+/**
+ * @file FlatHashMap.h
+ * @brief Open-addressing hash map keyed by 64-bit IDs
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace asioclient {
+
+/**
+ * @class FlatHashMap
+ * @brief Linear-probing map with backward-shift deletion, no tombstones
+ *
+ * All slots live in one contiguous array, so lookups touch one or two cache
+ * lines instead of chasing node pointers. Key 0 marks an empty slot and must
+ * not be inserted. Not thread-safe.
+ */
+template <typename Value>
+class FlatHashMap {
+public:
+    explicit FlatHashMap(size_t capacity = 16) {
+        size_t n = 16;
+        while (n < capacity * 2) {
+            n <<= 1;
+        }
+        slots_.resize(n);
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @return Pointer to the value, or nullptr; invalidated by insert/erase
+     */
+    Value* find(uint64_t key) {
+        for (size_t i = home(key);; i = next(i)) {
+            if (slots_[i].key == key) {
+                return &slots_[i].value;
+            }
+            if (slots_[i].key == 0) {
+                return nullptr;
+            }
+        }
+    }
+
+    /**
+     * @return false if the key is already present (value left untouched)
+     */
+    bool insert(uint64_t key, Value&& value) {
+        if ((size_ + 1) * 2 > slots_.size()) {
+            grow();
+        }
+
+        size_t i = home(key);
+        while (slots_[i].key != 0) {
+            if (slots_[i].key == key) {
+                return false;
+            }
+            i = next(i);
+        }
+        slots_[i].key = key;
+        slots_[i].value = std::move(value);
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief Remove a key, moving its value to *out when given
+     * @return false if the key was not present
+     */
+    bool erase(uint64_t key, Value* out = nullptr) {
+        size_t i = home(key);
+        while (slots_[i].key != key) {
+            if (slots_[i].key == 0) {
+                return false;
+            }
+            i = next(i);
+        }
+
+        if (out) {
+            *out = std::move(slots_[i].value);
+        }
+
+        // Shift later members of the probe run back so lookups never stop early
+        for (size_t j = next(i); slots_[j].key != 0; j = next(j)) {
+            size_t k = home(slots_[j].key);
+            bool movable = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+            if (movable) {
+                slots_[i] = std::move(slots_[j]);
+                i = j;
+            }
+        }
+        slots_[i].key = 0;
+        slots_[i].value = Value();
+        --size_;
+        return true;
+    }
+
+    /**
+     * @brief Move every value out to fn(key, value&&) and leave the map empty
+     */
+    template <typename Fn>
+    void drain(Fn&& fn) {
+        for (auto& slot : slots_) {
+            if (slot.key != 0) {
+                uint64_t key = slot.key;
+                slot.key = 0;
+                fn(key, std::move(slot.value));
+                slot.value = Value();
+            }
+        }
+        size_ = 0;
+    }
+
+private:
+    struct Slot {
+        uint64_t key = 0;
+        Value value{};
+    };
+
+    // splitmix64 finalizer: sequential IDs land on scattered slots
+    static uint64_t mix(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    size_t home(uint64_t key) const { return static_cast<size_t>(mix(key)) & (slots_.size() - 1); }
+    size_t next(size_t i) const { return (i + 1) & (slots_.size() - 1); }
+
+    void grow() {
+        std::vector<Slot> old(slots_.size() * 2);
+        old.swap(slots_);
+        size_ = 0;
+        for (auto& slot : old) {
+            if (slot.key != 0) {
+                insert(slot.key, std::move(slot.value));
+            }
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+};
+
+} // namespace asioclient
@@ -0,0 +1,198 @@
+/**
+ * @file Framing.h
+ * @brief Compile-time length-prefix framing policies for BasicTcpClient
+ *
+ * A framing policy is a stateless type providing:
+ *
+ *     static constexpr size_t kMinHeaderSize;   // Bytes decode() needs before it can succeed
+ *     static constexpr size_t kMaxHeaderSize;   // Largest header encode() writes / decode() reads
+ *     static constexpr size_t kMaxBodySize;     // Larger frames are rejected with message_size
+ *     static constexpr bool kCompression;       // Header carries COMPRESSED_FLAG
+ *
+ *     // Write the header for a body of `size` bytes, return its length
+ *     static size_t encode(size_t size, bool compressed, char* out);
+ *
+ *     // Parse a header from `available` bytes: its length, or 0 if more bytes
+ *     // are needed (never once kMaxHeaderSize bytes are available)
+ *     static size_t decode(const char* data, size_t available, FrameHeader& header);
+ *
+ * Everything is resolved at compile time and inlined into the read and
+ * write paths; malformed headers decode to a body size above kMaxBodySize.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "Message.h"
+
+namespace asioclient {
+
+/**
+ * @struct FrameHeader
+ * @brief Decoded length prefix
+ */
+struct FrameHeader {
+    size_t bodySize = 0;
+    bool compressed = false;
+};
+
+/**
+ * @struct BigEndian32Framing
+ * @brief [Length (4B, big-endian)][Body]: the original protocol and the default
+ *
+ * The top bit of the length is COMPRESSED_FLAG, so bodies stay below 2GB.
+ */
+template <size_t MaxBody = MAX_BODY_SIZE>
+struct BigEndian32Framing {
+    static_assert(MaxBody < COMPRESSED_FLAG, "length shares the header with COMPRESSED_FLAG");
+
+    static constexpr size_t kMinHeaderSize = 4;
+    static constexpr size_t kMaxHeaderSize = 4;
+    static constexpr size_t kMaxBodySize = MaxBody;
+    static constexpr bool kCompression = true;
+
+    static size_t encode(size_t size, bool compressed, char* out) {
+        Message::encodeHeader(static_cast<uint32_t>(size), out, compressed ? COMPRESSED_FLAG : 0);
+        return kMaxHeaderSize;
+    }
+
+    static size_t decode(const char* data, size_t available, FrameHeader& header) {
+        if (available < kMinHeaderSize) {
+            return 0;
+        }
+        header.bodySize = Message::decodeHeader(data);
+        header.compressed = Message::isCompressed(data);
+        return kMaxHeaderSize;
+    }
+};
+
+/**
+ * @struct BigEndian16Framing
+ * @brief [Length (2B, big-endian)][Body], bodies up to 64KB
+ */
+template <size_t MaxBody = 0xFFFF>
+struct BigEndian16Framing {
+    static_assert(MaxBody <= 0xFFFF, "16-bit length prefix");
+
+    static constexpr size_t kMinHeaderSize = 2;
+    static constexpr size_t kMaxHeaderSize = 2;
+    static constexpr size_t kMaxBodySize = MaxBody;
+    static constexpr bool kCompression = false;
+
+    static size_t encode(size_t size, bool /*compressed*/, char* out) {
+        out[0] = static_cast<char>((size >> 8) & 0xFF);
+        out[1] = static_cast<char>(size & 0xFF);
+        return kMaxHeaderSize;
+    }
+
+    static size_t decode(const char* data, size_t available, FrameHeader& header) {
+        if (available < kMinHeaderSize) {
+            return 0;
+        }
+        header.bodySize = (size_t(static_cast<unsigned char>(data[0])) << 8) |
+                          static_cast<unsigned char>(data[1]);
+        header.compressed = false;
+        return kMaxHeaderSize;
+    }
+};
+
+/**
+ * @struct LittleEndian64Framing
+ * @brief [Length (8B, little-endian)][Body]
+ *
+ * The wire allows any 64-bit length; MaxBody bounds what a peer can make the
+ * client allocate.
+ */
+template <size_t MaxBody = MAX_BODY_SIZE>
+struct LittleEndian64Framing {
+    static constexpr size_t kMinHeaderSize = 8;
+    static constexpr size_t kMaxHeaderSize = 8;
+    static constexpr size_t kMaxBodySize = MaxBody;
+    static constexpr bool kCompression = false;
+
+    static size_t encode(size_t size, bool /*compressed*/, char* out) {
+        uint64_t value = size;
+        for (size_t i = 0; i < 8; ++i) {
+            out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+        return kMaxHeaderSize;
+    }
+
+    static size_t decode(const char* data, size_t available, FrameHeader& header) {
+        if (available < kMinHeaderSize) {
+            return 0;
+        }
+        uint64_t value = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            value |= uint64_t(static_cast<unsigned char>(data[i])) << (8 * i);
+        }
+        header.bodySize = value > kMaxBodySize ? std::numeric_limits<size_t>::max()
+                                               : static_cast<size_t>(value);
+        header.compressed = false;
+        return kMaxHeaderSize;
+    }
+};
+
+/**
+ * @struct VarintFraming
+ * @brief [Length (unsigned LEB128, as protobuf's delimited streams)][Body]
+ *
+ * The header takes 1 byte below 128 and is at most as long as MaxBody's
+ * encoding; a longer run of continuation bytes is rejected.
+ */
+template <size_t MaxBody = MAX_BODY_SIZE>
+struct VarintFraming {
+    static constexpr size_t varintSize(uint64_t value) {
+        size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            ++size;
+        }
+        return size;
+    }
+
+    static constexpr size_t kMinHeaderSize = 1;
+    static constexpr size_t kMaxHeaderSize = varintSize(MaxBody);
+    static constexpr size_t kMaxBodySize = MaxBody;
+    static constexpr bool kCompression = false;
+
+    static size_t encode(size_t size, bool /*compressed*/, char* out) {
+        uint64_t value = size;
+        size_t n = 0;
+        while (value >= 0x80) {
+            out[n++] = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out[n++] = static_cast<char>(value);
+        return n;
+    }
+
+    static size_t decode(const char* data, size_t available, FrameHeader& header) {
+        uint64_t value = 0;
+        size_t limit = available < kMaxHeaderSize ? available : kMaxHeaderSize;
+        for (size_t i = 0; i < limit; ++i) {
+            auto byte = static_cast<unsigned char>(data[i]);
+            value |= uint64_t(byte & 0x7F) << (7 * i);
+            if ((byte & 0x80) == 0) {
+                header.bodySize = value > kMaxBodySize ? std::numeric_limits<size_t>::max()
+                                                       : static_cast<size_t>(value);
+                header.compressed = false;
+                return i + 1;
+            }
+        }
+        if (available < kMaxHeaderSize) {
+            return 0;
+        }
+
+        // Still continuing at the longest valid length
+        header.bodySize = std::numeric_limits<size_t>::max();
+        header.compressed = false;
+        return kMaxHeaderSize;
+    }
+};
+
+// The protocol TcpClient speaks
+using DefaultFraming = BigEndian32Framing<>;
+
+} // namespace asioclient
@@ -3,12 +3,21 @@
  * @brief Length-prefixed protocol for TCP message framing
  *
  * Protocol format: [Length (4B, network byte order)][Body (variable length)]
+ *
+ * Request/response extension (RpcClient): the body starts with a correlation
+ * ID, [Length][CorrelationId (8B, network byte order)][Payload].
+ *
+ * Compression extension (CompressionConfig): the top bit of the length header
+ * marks a compressed body, [Length | COMPRESSED_FLAG][Codec (1B)]
+ * [Original length (4B, network byte order)][Compressed data]. Bodies are
+ * limited to MAX_BODY_SIZE, so the bit is never set by a plain frame.
  */
 #pragma once
 
 #include <cstdint>
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 
@@ -24,36 +33,114 @@ namespace asioclient {
 // Protocol constants
 constexpr size_t HEADER_SIZE = 4;                    // Header size: 4 bytes
 constexpr size_t MAX_BODY_SIZE = 16 * 1024 * 1024;  // Max body size: 16MB
+constexpr size_t CORRELATION_ID_SIZE = 8;            // Correlation ID extension: 8 bytes
+constexpr uint32_t COMPRESSED_FLAG = 0x80000000u;    // Length header bit: compressed body
+constexpr size_t INLINE_BODY_SIZE = 96;              // Bodies up to this size live inside Message
 
 /**
  * @class Message
  * @brief Message class for protocol encoding/decoding
+ *
+ * Bodies of up to INLINE_BODY_SIZE bytes are stored inside the object, so
+ * small messages are built, sent and received without touching the heap.
+ * A vector passed by rvalue is adopted as is, whatever its size. body()
+ * const returns a copy and body() moves an inline body to the heap; prefer
+ * data()/bodySize() for reading.
  */
 class Message {
 public:
     // Constructors
     Message() = default;
-    explicit Message(const std::string& body)
-        : body_(body.begin(), body.end()) {}
-    explicit Message(const std::vector<char>& body)
-        : body_(body) {}
+    explicit Message(const std::string& body) { setBody(body.data(), body.size()); }
+    explicit Message(const std::vector<char>& body) { setBody(body.data(), body.size()); }
     explicit Message(std::vector<char>&& body)
-        : body_(std::move(body)) {}
+        : heap_(std::move(body)), onHeap_(true) {}
+    Message(const char* data, size_t len) { setBody(data, len); }
+
+    // Copies and moves touch only the inline bytes in use
+    Message(const Message& other) { *this = other; }
+    Message(Message&& other) noexcept { *this = std::move(other); }
+    Message& operator=(const Message& other) {
+        if (this != &other) {
+            heap_ = other.heap_;
+            copyInline(other);
+        }
+        return *this;
+    }
+    Message& operator=(Message&& other) noexcept {
+        if (this != &other) {
+            heap_ = std::move(other.heap_);
+            copyInline(other);
+        }
+        return *this;
+    }
 
     // Accessors
-    const std::vector<char>& body() const { return body_; }
-    std::vector<char>& body() { return body_; }
-    size_t bodySize() const { return body_.size(); }
+    const char* data() const { return onHeap_ ? heap_.data() : inline_; }
+    char* data() { return onHeap_ ? heap_.data() : inline_; }
+    size_t bodySize() const { return onHeap_ ? heap_.size() : inlineSize_; }
+    bool empty() const { return bodySize() == 0; }
+    bool isInline() const { return !onHeap_; }
+    std::string_view bodyAsStringView() const {
+        return std::string_view(data(), bodySize());
+    }
     std::string bodyAsString() const {
-        return std::string(body_.begin(), body_.end());
+        return std::string(data(), bodySize());
+    }
+
+    /**
+     * @brief Copy of the body as a vector
+     *
+     * Never modifies the message, so concurrent readers are safe; read
+     * through data()/bodySize() to avoid the copy.
+     */
+    std::vector<char> body() const {
+        return std::vector<char>(data(), data() + bodySize());
+    }
+
+    /**
+     * @brief Heap storage of the body, for moving it out or editing it as a vector
+     *
+     * An inline body is copied to the heap first (one allocation).
+     */
+    std::vector<char>& body() {
+        if (!onHeap_) {
+            heap_.assign(inline_, inline_ + inlineSize_);
+            inlineSize_ = 0;
+            onHeap_ = true;
+        }
+        return heap_;
     }
 
     // Mutators
     void setBody(const std::string& data) {
-        body_.assign(data.begin(), data.end());
+        setBody(data.data(), data.size());
     }
     void setBody(const char* data, size_t len) {
-        body_.assign(data, data + len);
+        if (!onHeap_ && len <= INLINE_BODY_SIZE) {
+            if (len > 0) {
+                std::memmove(inline_, data, len);
+            }
+            inlineSize_ = static_cast<uint32_t>(len);
+            return;
+        }
+        body().assign(data, data + len);
+    }
+
+    /**
+     * @brief Resize the body, keeping its leading bytes
+     *
+     * Stays inline while the new size fits; new bytes are zero.
+     */
+    void resize(size_t len) {
+        if (!onHeap_ && len <= INLINE_BODY_SIZE) {
+            if (len > inlineSize_) {
+                std::memset(inline_ + inlineSize_, 0, len - inlineSize_);
+            }
+            inlineSize_ = static_cast<uint32_t>(len);
+            return;
+        }
+        body().resize(len);
     }
 
     /**
@@ -62,29 +149,71 @@ public:
      */
     std::vector<char> encode() const {
         std::vector<char> result;
-        result.resize(HEADER_SIZE + body_.size());
+        result.resize(HEADER_SIZE + bodySize());
 
-        // Convert length to network byte order
-        uint32_t len = htonl(static_cast<uint32_t>(body_.size()));
-        std::memcpy(result.data(), &len, HEADER_SIZE);
+        encodeHeader(static_cast<uint32_t>(bodySize()), result.data());
 
         // Copy body if present
-        if (!body_.empty()) {
-            std::memcpy(result.data() + HEADER_SIZE, body_.data(), body_.size());
+        if (!empty()) {
+            std::memcpy(result.data() + HEADER_SIZE, data(), bodySize());
         }
 
         return result;
     }
 
+    /**
+     * @brief Encode length header in place
+     * @param bodyLen Body length in host byte order
+     * @param out Buffer with room for at least HEADER_SIZE bytes
+     * @param flags Header flag bits (COMPRESSED_FLAG)
+     */
+    static void encodeHeader(uint32_t bodyLen, char* out, uint32_t flags = 0) {
+        // Convert length to network byte order
+        uint32_t len = htonl(bodyLen | flags);
+        std::memcpy(out, &len, HEADER_SIZE);
+    }
+
     /**
      * @brief Decode length header from buffer
      * @param data Buffer containing at least HEADER_SIZE bytes
-     * @return Body length in host byte order
+     * @return Body length in host byte order, flag bits masked off
      */
     static uint32_t decodeHeader(const char* data) {
         uint32_t len;
         std::memcpy(&len, data, HEADER_SIZE);
-        return ntohl(len);
+        return ntohl(len) & ~COMPRESSED_FLAG;
+    }
+
+    /**
+     * @brief Whether the header marks a compressed body
+     * @param data Buffer containing at least HEADER_SIZE bytes
+     */
+    static bool isCompressed(const char* data) {
+        return (static_cast<unsigned char>(data[0]) & 0x80) != 0;
+    }
+
+    /**
+     * @brief Encode a correlation ID in place
+     * @param id Correlation ID in host byte order
+     * @param out Buffer with room for at least CORRELATION_ID_SIZE bytes
+     */
+    static void encodeCorrelationId(uint64_t id, char* out) {
+        for (size_t i = 0; i < CORRELATION_ID_SIZE; ++i) {
+            out[i] = static_cast<char>((id >> (8 * (CORRELATION_ID_SIZE - 1 - i))) & 0xff);
+        }
+    }
+
+    /**
+     * @brief Decode a correlation ID from buffer
+     * @param data Buffer containing at least CORRELATION_ID_SIZE bytes
+     * @return Correlation ID in host byte order
+     */
+    static uint64_t decodeCorrelationId(const char* data) {
+        uint64_t id = 0;
+        for (size_t i = 0; i < CORRELATION_ID_SIZE; ++i) {
+            id = (id << 8) | static_cast<unsigned char>(data[i]);
+        }
+        return id;
     }
 
     /**
@@ -97,7 +226,79 @@ public:
     }
 
 private:
-    std::vector<char> body_;  // Message body storage
+    void copyInline(const Message& other) {
+        onHeap_ = other.onHeap_;
+        inlineSize_ = other.inlineSize_;
+        if (inlineSize_ > 0) {
+            std::memcpy(inline_, other.inline_, inlineSize_);
+        }
+    }
+
+    std::vector<char> heap_;         // Body storage once on the heap
+    uint32_t inlineSize_ = 0;        // Bytes used in inline_ while !onHeap_
+    bool onHeap_ = false;            // Body lives in heap_
+    char inline_[INLINE_BODY_SIZE];  // Small-body storage, read only up to inlineSize_
+};
+
+/**
+ * @class MessageView
+ * @brief Non-owning view of a received message body
+ *
+ * Points into the client's receive buffer and is only valid for the duration
+ * of the callback; use toMessage() to keep a copy.
+ */
+class MessageView {
+public:
+    MessageView() = default;
+    MessageView(const char* data, size_t size)
+        : data_(data), size_(size) {}
+
+    // Accessors
+    const char* data() const { return data_; }
+    size_t bodySize() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::string_view bodyAsStringView() const {
+        return std::string_view(data_, size_);
+    }
+    std::string bodyAsString() const {
+        return std::string(data_, size_);
+    }
+
+    /**
+     * @brief Copy the viewed body into an owning Message
+     */
+    Message toMessage() const {
+        return Message(data_, size_);
+    }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @class MessageBatch
+ * @brief Non-owning span of the MessageViews parsed from one receive
+ *
+ * Same lifetime as MessageView: the views and the bytes they point to are
+ * only valid for the duration of the callback.
+ */
+class MessageBatch {
+public:
+    MessageBatch() = default;
+    MessageBatch(const MessageView* views, size_t count)
+        : views_(views), count_(count) {}
+
+    // Accessors
+    const MessageView* begin() const { return views_; }
+    const MessageView* end() const { return views_ + count_; }
+    const MessageView& operator[](size_t i) const { return views_[i]; }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+private:
+    const MessageView* views_ = nullptr;
+    size_t count_ = 0;
 };
 
 } // namespace asioclient
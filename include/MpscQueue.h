@@ -0,0 +1,169 @@
+/**
+ * @file MpscQueue.h
+ * @brief Lock-free multi-producer single-consumer queue
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace asioclient {
+
+/**
+ * @class MpscQueue
+ * @brief Unbounded linked-list MPSC queue (Vyukov)
+ *
+ * push() may be called from any thread and never blocks; push costs one
+ * atomic exchange. pop()/pending() must only be called from the single
+ * consumer (the client's IO thread).
+ *
+ * Nodes are recycled per T, across queues: the consumer keeps freed nodes in
+ * its thread's cache and hands the overflow to a shared stack, which a
+ * producer with an empty cache takes whole (one exchange, so no ABA). Once
+ * warm, push() does not allocate.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue()
+        : head_(acquireNode())
+        , tail_(head_.load(std::memory_order_relaxed)) {}
+
+    ~MpscQueue() {
+        T value;
+        while (pop(value)) {
+        }
+        recycle(tail_);
+    }
+
+    // Non-copyable
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Append a value (any thread)
+     */
+    void push(T&& value) {
+        Node* node = acquireNode();
+        node->value.emplace(std::move(value));
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Remove the oldest value (consumer only)
+     * @return false if the queue is empty or the next push is not linked yet
+     */
+    bool pop(T& out) {
+        Node* next = tail_->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+
+        out = std::move(*next->value);
+        next->value.reset();
+        recycle(tail_);
+        tail_ = next;
+        return true;
+    }
+
+    /**
+     * @brief Whether a producer is part-way through push() (consumer only)
+     *
+     * True when pop() failed although the queue is not empty; the consumer
+     * must retry later or the value is stranded.
+     */
+    bool pending() const {
+        return head_.load(std::memory_order_acquire) != tail_ &&
+               !tail_->next.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};  // Queue link, or free list link while cached
+        std::optional<T> value;
+    };
+
+    static constexpr size_t kThreadCacheNodes = 256;     // Kept by each thread
+    static constexpr ptrdiff_t kSharedCacheNodes = 1024; // Beyond this, freed nodes are deleted
+
+    struct ThreadCache {
+        ~ThreadCache() { deleteChain(head); }
+        Node* head = nullptr;
+        size_t size = 0;
+    };
+    struct SharedCache {
+        ~SharedCache() { deleteChain(head.load(std::memory_order_acquire)); }
+        std::atomic<Node*> head{nullptr};
+        std::atomic<ptrdiff_t> size{0};  // Approximate
+    };
+
+    static ThreadCache& threadCache() {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+    static SharedCache& sharedCache() {
+        static SharedCache cache;
+        return cache;
+    }
+
+    static Node* acquireNode() {
+        ThreadCache& local = threadCache();
+        if (!local.head) {
+            SharedCache& shared = sharedCache();
+            if (shared.head.load(std::memory_order_relaxed)) {
+                local.head = shared.head.exchange(nullptr, std::memory_order_acquire);
+                for (Node* node = local.head; node; node = node->next.load(std::memory_order_relaxed)) {
+                    ++local.size;
+                }
+                shared.size.fetch_sub(static_cast<ptrdiff_t>(local.size), std::memory_order_relaxed);
+            }
+        }
+
+        Node* node = local.head;
+        if (!node) {
+            return new Node();
+        }
+        local.head = node->next.load(std::memory_order_relaxed);
+        --local.size;
+        node->next.store(nullptr, std::memory_order_relaxed);
+        return node;
+    }
+
+    static void recycle(Node* node) {
+        ThreadCache& local = threadCache();
+        if (local.size < kThreadCacheNodes) {
+            node->next.store(local.head, std::memory_order_relaxed);
+            local.head = node;
+            ++local.size;
+            return;
+        }
+
+        SharedCache& shared = sharedCache();
+        if (shared.size.load(std::memory_order_relaxed) >= kSharedCacheNodes) {
+            delete node;
+            return;
+        }
+        shared.size.fetch_add(1, std::memory_order_relaxed);
+        Node* top = shared.head.load(std::memory_order_relaxed);
+        do {
+            node->next.store(top, std::memory_order_relaxed);
+        } while (!shared.head.compare_exchange_weak(top, node, std::memory_order_release,
+                                                    std::memory_order_relaxed));
+    }
+
+    static void deleteChain(Node* node) {
+        while (node) {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            delete node;
+            node = next;
+        }
+    }
+
+    alignas(64) std::atomic<Node*> head_;  // Last pushed node (producers)
+    alignas(64) Node* tail_;               // Consumed stub node (consumer)
+};
+
+} // namespace asioclient
@@ -0,0 +1,90 @@
+/**
+ * @file RecyclingAllocator.h
+ * @brief Allocator that keeps freed blocks of one size for reuse
+ */
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace asioclient {
+
+/**
+ * @class RecyclingAllocator
+ * @brief std::allocator replacement for containers that churn equal-size blocks
+ *
+ * A std::deque used as a FIFO frees a buffer each time its front moves past
+ * one and allocates a new one as the back grows, all of the same size. Up to
+ * MaxCached freed blocks of that size are kept in the allocator instance and
+ * handed out again; anything else goes to operator new/delete. Caches are not
+ * shared between copies, and any instance can free any block, so all
+ * instances compare equal. Not thread-safe, like the container using it.
+ */
+template <typename T, size_t MaxCached = 64>
+class RecyclingAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = RecyclingAllocator<U, MaxCached>;
+    };
+
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned types need aligned new");
+
+    RecyclingAllocator() noexcept = default;
+    RecyclingAllocator(const RecyclingAllocator&) noexcept {}
+    template <typename U>
+    RecyclingAllocator(const RecyclingAllocator<U, MaxCached>&) noexcept {}
+    RecyclingAllocator& operator=(const RecyclingAllocator&) noexcept { return *this; }
+
+    ~RecyclingAllocator() {
+        while (free_) {
+            Block* next = free_->next;
+            ::operator delete(free_);
+            free_ = next;
+        }
+    }
+
+    T* allocate(size_t n) {
+        if (free_ && n == cachedSize_) {
+            Block* block = free_;
+            free_ = block->next;
+            --cached_;
+            return reinterpret_cast<T*>(block);
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        // The size of the first block kept becomes the cached size
+        if (n * sizeof(T) >= sizeof(Block) && cached_ < MaxCached && (cached_ == 0 || n == cachedSize_)) {
+            Block* block = reinterpret_cast<Block*>(p);
+            block->next = free_;
+            free_ = block;
+            cachedSize_ = n;
+            ++cached_;
+            return;
+        }
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const RecyclingAllocator<U, MaxCached>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const RecyclingAllocator<U, MaxCached>&) const noexcept { return false; }
+
+private:
+    struct Block {
+        Block* next;
+    };
+
+    Block* free_ = nullptr;
+    size_t cachedSize_ = 0;  // Element count of the cached blocks
+    size_t cached_ = 0;
+};
+
+} // namespace asioclient
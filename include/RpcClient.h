@@ -0,0 +1,141 @@
+/**
+ * @file RpcClient.h
+ * @brief Pipelined request/response client over TcpClient
+ */
+#pragma once
+
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "TcpClient.h"
+#include "FlatHashMap.h"
+#include "Completion.h"
+#include "TimerWheel.h"
+
+namespace asioclient {
+
+/**
+ * @class RpcClient
+ * @brief Correlates responses to requests sent over one TcpClient
+ *
+ * Each request body is prefixed with a fresh correlation ID (see Message.h);
+ * the server must echo it in front of the response. Any number of requests
+ * may be in flight and responses may arrive in any order. Pending requests
+ * live in a flat hash map and their deadlines on the io_context's shared
+ * TimerWheel (rounded up to its tick).
+ *
+ * The RpcClient owns the message view and disconnected callbacks of its
+ * TcpClient; use setOnUnmatched() / setOnDisconnected() here instead.
+ * Requests go out with sendNoReplay(): when the connection drops (or a
+ * reconnect attempt fails), a request whose frame was not fully written is
+ * dropped and fails with that error rather than being resent, and one already
+ * written fails with connection_reset. The server therefore never sees a
+ * request its caller was told failed. After a user disconnect() the queued
+ * ones fail with operation_aborted; call cancelAll() for the rest.
+ *
+ * The request handler runs on the thread delivering the outcome (client or
+ * TimerWheel strand); asyncRequest() completions run on their associated
+ * executor.
+ * request() / asyncRequest() / cancelAll() are thread-safe.
+ */
+class RpcClient : public std::enable_shared_from_this<RpcClient> {
+public:
+    using ResponseHandler = std::function<void(boost::system::error_code, Message)>;
+    using MessageCallback = TcpClient::MessageCallback;
+    using DisconnectedCallback = TcpClient::DisconnectedCallback;
+    using DefaultCompletionToken = TcpClient::DefaultCompletionToken;
+
+    explicit RpcClient(asio::io_context& ioContext);
+
+    // Non-copyable
+    RpcClient(const RpcClient&) = delete;
+    RpcClient& operator=(const RpcClient&) = delete;
+
+    /**
+     * @brief Underlying connection: connect, configure and send plain messages here
+     */
+    const TcpClientPtr& client() const { return client_; }
+
+    /**
+     * @brief Send a request; handler gets the response payload (ID stripped)
+     * @param timeout Deadline (<= 0 = none); expiry fails with timed_out
+     *
+     * Fails with no_buffer_space if the write queue rejects the request.
+     */
+    void request(Message message, std::chrono::milliseconds timeout, ResponseHandler handler);
+
+    /**
+     * @brief Completion-token form of request(), signature void(error_code, Message)
+     *
+     * e.g. `Message reply = co_await rpc->asyncRequest(msg, 100ms);` or
+     * `auto reply = rpc->asyncRequest(msg, 100ms, asio::use_future);`
+     */
+    template <typename CompletionToken = DefaultCompletionToken>
+    auto asyncRequest(Message message, std::chrono::milliseconds timeout,
+                      CompletionToken&& token = DefaultCompletionToken()) {
+        return asio::async_initiate<CompletionToken, void(boost::system::error_code, Message)>(
+            [this](auto handler, Message&& message, std::chrono::milliseconds timeout) {
+                request(std::move(message), timeout,
+                        bindCompletion<boost::system::error_code, Message>(
+                            std::move(handler), strand_));
+            },
+            token, std::move(message), timeout);
+    }
+
+    /**
+     * @brief Fail every pending request with operation_aborted
+     */
+    void cancelAll() { failAll(asio::error::operation_aborted); }
+
+    // Requests waiting for a response
+    size_t pendingRequests() const;
+
+    // Frames without a pending correlation ID (server pushes, late responses)
+    void setOnUnmatched(MessageCallback cb) { onUnmatched_ = std::move(cb); }
+    void setOnDisconnected(DisconnectedCallback cb) { onDisconnected_ = std::move(cb); }
+
+private:
+    friend std::shared_ptr<RpcClient> createRpcClient(asio::io_context&);
+
+    struct PendingRequest {
+        ResponseHandler handler;
+        TimerWheel::TimerId deadline = 0;  // 0 = no deadline
+        bool written = false;              // The frame reached the socket
+    };
+
+    void attach();
+    void onResponse(const MessageView& view);
+    void onDeadline(uint64_t id);
+    void onSent(uint64_t id, const boost::system::error_code& ec);
+    void failAll(const boost::system::error_code& ec, bool writtenOnly = false);
+
+    asio::strand<asio::io_context::executor_type> strand_;  // Default executor of asyncRequest()
+    TimerWheelPtr timerWheel_;
+    TcpClientPtr client_;
+
+    mutable std::mutex mutex_;                       // Guards pending_
+    FlatHashMap<PendingRequest> pending_;
+
+    std::atomic<uint64_t> nextId_{1};                // 0 is not a valid correlation ID
+
+    // Callbacks
+    MessageCallback onUnmatched_;
+    DisconnectedCallback onDisconnected_;
+};
+
+using RpcClientPtr = std::shared_ptr<RpcClient>;
+
+/**
+ * @brief Factory function to create RpcClient instance
+ * @param ioContext IO context (shared by the underlying TcpClient)
+ * @return Shared pointer to RpcClient
+ */
+RpcClientPtr createRpcClient(asio::io_context& ioContext);
+
+} // namespace asioclient
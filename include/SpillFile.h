@@ -0,0 +1,84 @@
+/**
+ * @file SpillFile.h
+ * @brief Memory-mapped FIFO of outbound frames for long outages
+ */
+#pragma once
+
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace asioclient {
+
+/**
+ * @class SpillFile
+ * @brief Fixed-size file mapped into memory and used as a byte ring of frames
+ *
+ * Each record is [enqueue timestamp (8B)][body size (8B)][header size (1B)]
+ * [frame header][body], so any framing policy's headers fit. Bodies
+ * live in the page cache instead of the heap, so a backlog built up while a
+ * backend is down costs file pages the kernel can write back and evict.
+ * The file is created sparse, sized once, and removed when closed.
+ *
+ * Not thread-safe: owned by one client and used on its strand only.
+ */
+class SpillFile {
+public:
+    SpillFile();
+    ~SpillFile();
+
+    // Non-copyable
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    /**
+     * @brief Create (or truncate) the file at path and map capacity bytes
+     * @return false with ec set if the file cannot be created or mapped
+     */
+    bool open(const std::string& path, size_t capacity, boost::system::error_code& ec);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+
+    /**
+     * @brief Append a frame
+     * @return false if the ring has no room for it
+     */
+    bool push(int64_t stamp, const char* header, size_t headerSize,
+              const char* body, size_t size);
+
+    /**
+     * @brief Remove the oldest frame into header/body
+     * @param header Must hold the largest header pushed
+     * @return false if empty
+     */
+    bool pop(int64_t& stamp, char* header, size_t& headerSize, std::vector<char>& body);
+
+    // Drop every record
+    void clear();
+
+    bool empty() const { return records_ == 0; }
+    size_t size() const { return records_; }       // Records
+    size_t bytes() const { return used_; }         // Bytes in use, record prefixes included
+    size_t capacity() const { return capacity_; }
+
+    static constexpr size_t RECORD_PREFIX = sizeof(int64_t) + sizeof(uint64_t) + 1;
+
+private:
+    struct Mapping;
+
+    void writeAt(size_t offset, const void* data, size_t size);
+    void readAt(size_t offset, void* data, size_t size) const;
+
+    std::unique_ptr<Mapping> mapping_;
+    std::string path_;
+    char* data_{nullptr};
+    size_t capacity_{0};
+    size_t head_{0};      // Offset of the oldest record
+    size_t used_{0};
+    size_t records_{0};
+};
+
+} // namespace asioclient
@@ -0,0 +1,117 @@
+/**
+ * @file SpscRing.h
+ * @brief Bounded lock-free single-producer single-consumer ring
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace asioclient {
+
+/**
+ * @class SpscRing
+ * @brief Fixed-capacity ring of T slots (capacity rounded up to a power of two)
+ *
+ * tryPush() must only be called from the producer and tryPop()/drain() from
+ * the consumer; each side caches the other's index, so an uncontended push
+ * or pop touches no shared cache line. Slots are allocated once, up front.
+ */
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+        : mask_(roundUp(capacity) - 1)
+        , slots_(mask_ + 1) {}
+
+    // Non-copyable
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Append a value (producer only)
+     * @return false if the ring is full; value is left untouched
+     */
+    bool tryPush(T&& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ > mask_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ > mask_) {
+                return false;
+            }
+        }
+
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest value (consumer only)
+     * @return false if the ring is empty
+     */
+    bool tryPop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) {
+                return false;
+            }
+        }
+
+        out = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Hand up to maxCount values to fn(T&), oldest first (consumer only)
+     *
+     * The slots are released to the producer once, after the last call.
+     * @return Number of values consumed
+     */
+    template <typename Fn>
+    size_t drain(Fn&& fn, size_t maxCount = static_cast<size_t>(-1)) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        tailCache_ = tail_.load(std::memory_order_acquire);
+        size_t count = tailCache_ - head;
+        if (count > maxCount) {
+            count = maxCount;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            T value = std::move(slots_[(head + i) & mask_]);
+            fn(value);
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Approximate from either side
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    static size_t roundUp(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    const size_t mask_;
+    std::vector<T> slots_;
+
+    alignas(64) std::atomic<size_t> tail_{0};  // Next slot to fill (producer)
+    size_t headCache_{0};                      // Producer's view of head_
+    alignas(64) std::atomic<size_t> head_{0};  // Next slot to consume (consumer)
+    size_t tailCache_{0};                      // Consumer's view of tail_
+};
+
+} // namespace asioclient
@@ -8,20 +8,50 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <queue>
-#include <mutex>
+#include <array>
+#include <deque>
 #include <atomic>
 #include <functional>
 #include <chrono>
+#include <random>
 #include "Message.h"
+#include "Framing.h"
+#include "BufferPool.h"
+#include "MpscQueue.h"
+#include "RecyclingAllocator.h"
+#include "SpscRing.h"
+#include "Connector.h"
+#include "ClientStats.h"
+#include "Completion.h"
+#include "TimerWheel.h"
+#include "Compression.h"
+#include "Transport.h"
+#include "TokenBucket.h"
+#include "SpillFile.h"
+#include "ZeroCopy.h"
 
 namespace asio = boost::asio;
 
 namespace asioclient {
 
+/**
+ * @enum ReconnectJitter
+ * @brief Randomization of the backoff delay d = min(maxDelay, initialDelay * multiplier^n)
+ */
+enum class ReconnectJitter {
+    None,          // Exactly d
+    Full,          // Uniform in [0, d]
+    Equal,         // d/2 plus uniform in [0, d/2]
+    Decorrelated   // Uniform in [initialDelay, 3 * previous delay], capped by maxDelay
+};
+
 /**
  * @struct ReconnectConfig
  * @brief Auto-reconnect configuration with exponential backoff
+ *
+ * Clients that lose a shared server at the same moment retry in lockstep with
+ * a deterministic backoff; jitter spreads them out, and a connect limiter
+ * shared by all of them caps the rate at which they can hit the server.
  */
 struct ReconnectConfig {
     bool enabled = true;
@@ -29,6 +59,200 @@ struct ReconnectConfig {
     std::chrono::milliseconds maxDelay{30000};     // Max delay: 30s
     double backoffMultiplier = 2.0;                // Backoff multiplier
     int maxRetries = -1;                           // Max retries (-1 = infinite)
+    std::chrono::milliseconds dnsCacheTtl{0};      // Reuse resolved endpoints this long (0 = always resolve)
+    ReconnectJitter jitter = ReconnectJitter::None;
+    TokenBucketPtr connectLimiter;                 // Shared connects/s budget, also for connect() (null = unlimited)
+};
+
+/**
+ * @enum BackpressurePolicy
+ * @brief What send() does once the write queue is above the high watermark
+ */
+enum class BackpressurePolicy {
+    None,        // Unbounded queue
+    Reject,      // send() returns false until the queue drains below the high watermark
+    DropOldest,  // Accept, and drop the oldest frames not yet being written
+    Notify       // Accept; onBackpressure at the high and onWritable at the low watermark
+};
+
+/**
+ * @struct WriteConfig
+ * @brief Write path configuration (gather-write batching, backpressure)
+ *
+ * With batching enabled, every queued message (up to the caps below) is handed
+ * to the kernel as one scatter/gather buffer sequence, i.e. a single writev()
+ * per completion instead of one write per message.
+ *
+ * Cork mode trades latency for throughput: queued frames are held back until
+ * corkBytes are queued, the first of them has waited corkDelay, or flush() is
+ * called, and are then copied into one contiguous buffer per write (frames of
+ * corkBytes or more are written on their own, without the copy).
+ *
+ * Watermarks count queued bytes (headers included). With any policy other
+ * than None, onBackpressure fires when the queue rises above highWatermark
+ * and onWritable once it has drained to lowWatermark.
+ *
+ * Frames of zeroCopyThreshold bytes or more are written on their own with
+ * MSG_ZEROCOPY (Linux, plain TCP): the kernel sends straight from the body,
+ * which stays pinned until its completion arrives on the socket error queue.
+ * Pinning costs more than copying small frames; use it for bodies of 64KB
+ * and up. Without kernel support frames are written as usual.
+ */
+struct WriteConfig {
+    bool batching = false;                 // Flush the whole write queue in one async_write
+    size_t maxBatchBytes = 256 * 1024;     // Max bytes per batch: 256KB
+    size_t maxBatchBuffers = 64;           // Max buffers per batch (keep below IOV_MAX)
+
+    bool cork = false;                     // Coalesce sends, flush by size or deadline
+    size_t corkBytes = 64 * 1024;          // Flush once this much is queued: 64KB
+    std::chrono::microseconds corkDelay{200};  // Flush once the oldest held frame is this old
+
+    BackpressurePolicy backpressure = BackpressurePolicy::None;
+    size_t highWatermark = 16 * 1024 * 1024;  // High watermark: 16MB
+    size_t lowWatermark = 4 * 1024 * 1024;    // Low watermark: 4MB
+
+    size_t zeroCopyThreshold = 0;          // MSG_ZEROCOPY for frames this large (0 = off)
+};
+
+/**
+ * @struct PacingConfig
+ * @brief Token-bucket pacing of the write loop, in bytes/s and messages/s
+ *
+ * Each write takes only as many queued frames as the buckets hold tokens for,
+ * so a large batch goes out in budget-sized pieces; when the buckets are
+ * empty the write waits on a timer instead of going out as a burst. Frames
+ * are never split: one larger than the burst is written whole once its
+ * tokens have accrued. Headers and heartbeats count.
+ *
+ * The shared buckets cap a group of clients (e.g. every connection of a
+ * TcpClientPool) on top of each client's own rates; give all of them the
+ * same TokenBucketPtr.
+ */
+struct PacingConfig {
+    double bytesPerSecond = 0;             // Per-client byte rate (0 = unlimited)
+    double messagesPerSecond = 0;          // Per-client frame rate (0 = unlimited)
+    size_t burstBytes = 64 * 1024;         // Byte bucket capacity: 64KB
+    size_t burstMessages = 64;             // Frame bucket capacity
+    TokenBucketPtr sharedBytes;            // Shared bytes/s budget (null = none)
+    TokenBucketPtr sharedMessages;         // Shared frames/s budget (null = none)
+};
+
+/**
+ * @struct ReadConfig
+ * @brief Read path configuration (read-ahead receive buffer)
+ *
+ * With read-ahead enabled, the client reads whatever the socket has into a
+ * large buffer with async_read_some and parses every complete frame in it
+ * before issuing the next read, instead of two exact-size reads per frame.
+ */
+struct ReadConfig {
+    bool readAhead = false;                // Parse many frames per recv
+    size_t bufferSize = 64 * 1024;         // Read-ahead buffer size: 64KB (grows for larger frames)
+    size_t maxReceiveQueue = 1024;         // asyncReceive() backlog before reading pauses
+};
+
+/**
+ * @enum DispatchMode
+ * @brief Where received messages are handed to the application
+ */
+enum class DispatchMode {
+    Inline,    // Callbacks on the client's strand (onMessage / onMessageView / onMessageBatch)
+    Ring,      // Pushed into DispatchConfig::ring, drained by the consumer thread
+    Executor   // Batched and posted to DispatchConfig::executor, delivered to onDispatch
+};
+
+using MessageRing = SpscRing<Message>;
+using MessageRingPtr = std::shared_ptr<MessageRing>;
+
+/**
+ * @struct DispatchConfig
+ * @brief Hand received messages off the IO thread
+ *
+ * Ring and Executor modes take the place of the message callbacks and of
+ * asyncReceive(): every frame becomes an owning Message and the strand goes
+ * straight back to reading. Both are bounded: while the ring is full or
+ * maxPendingBatches posts are outstanding, reading pauses as it does for a
+ * full asyncReceive() queue. A ring has a single producer, so give each
+ * client its own.
+ */
+struct DispatchConfig {
+    DispatchMode mode = DispatchMode::Inline;
+    MessageRingPtr ring;                          // Ring mode
+    std::chrono::microseconds ringRetry{100};     // Ring full: retry interval while reading is paused
+    asio::any_io_executor executor;               // Executor mode
+    size_t maxBatch = 256;                        // Executor: messages per post
+    size_t maxPendingBatches = 16;                // Executor: posts in flight before reading pauses
+};
+
+/**
+ * @struct TimeoutConfig
+ * @brief Connection liveness timeouts, checked on the io_context's TimerWheel
+ *
+ * An expired timeout closes the connection with asio::error::timed_out
+ * (onError, then the usual reconnect). Granularity is the wheel tick.
+ */
+struct TimeoutConfig {
+    std::chrono::milliseconds readIdle{0};    // Nothing received for this long (0 = off)
+    std::chrono::milliseconds writeStall{0};  // One async_write pending for this long (0 = off)
+};
+
+/**
+ * @struct HeartbeatConfig
+ * @brief Application-level heartbeat with zero-length frames
+ *
+ * While enabled, a zero-length frame is written whenever nothing else has
+ * been written for one interval, and zero-length frames received are counted
+ * as heartbeats instead of being delivered to onMessage / onMessageView /
+ * onMessageBatch / asyncReceive(). The peer should echo them (or send its own); receiving
+ * nothing at all for missedIntervals intervals closes the connection with
+ * asio::error::timed_out and takes the reconnect path.
+ */
+struct HeartbeatConfig {
+    std::chrono::milliseconds interval{0};  // Ping after this long without writing (0 = off)
+    int missedIntervals = 3;                // Silent intervals before the peer is considered dead
+};
+
+/**
+ * @struct TcpKeepaliveConfig
+ * @brief Kernel TCP keepalive (SO_KEEPALIVE) and its probe timing
+ *
+ * The timing options are applied where the platform has them
+ * (TCP_KEEPIDLE / TCP_KEEPALIVE, TCP_KEEPINTVL, TCP_KEEPCNT).
+ */
+struct TcpKeepaliveConfig {
+    bool enabled = false;
+    std::chrono::seconds idle{60};      // Idle time before the first probe
+    std::chrono::seconds interval{10};  // Time between unanswered probes
+    int probes = 3;                     // Unanswered probes before the connection is dropped
+};
+
+/**
+ * @enum ReplayPolicy
+ * @brief What happens to outbound frames when the connection is lost
+ *
+ * A frame is never resent partially: the framing restarts on the new
+ * connection, so the frames of a write that failed midway go out whole again.
+ */
+enum class ReplayPolicy {
+    RetryFromFront,  // Keep the queue; frames not fully written are resent first
+    Drop,            // Fail everything queued with the disconnect error
+    AtLeastOnce      // Keep written frames until acknowledge(); unacked ones are resent first
+};
+
+/**
+ * @struct ReplayConfig
+ * @brief Replay semantics across reconnects and the optional spill file
+ *
+ * With a spill path, frames queued beyond spillThreshold go to a memory-mapped
+ * file instead of the heap and are read back in order once the connection is
+ * up and the in-memory queue has drained. Heartbeats are never spilled or
+ * retained.
+ */
+struct ReplayConfig {
+    ReplayPolicy policy = ReplayPolicy::RetryFromFront;
+    std::string spillPath;                     // Spill file (empty = keep everything in memory)
+    size_t spillThreshold = 8 * 1024 * 1024;   // Queued bytes kept on the heap: 8MB
+    size_t spillCapacity = 256 * 1024 * 1024;  // Spill file size: 256MB
 };
 
 /**
@@ -43,98 +267,578 @@ enum class ClientState {
 };
 
 /**
- * @class TcpClient
+ * @class BasicTcpClient
  * @brief Async TCP client with Proactor pattern
+ *
+ * Framing is the length-prefix policy (see Framing.h), resolved at compile
+ * time; TcpClient is BasicTcpClient<DefaultFraming>, the 4-byte big-endian
+ * protocol. Compression needs a policy with a flag bit (kCompression).
+ *
+ * Threading: every handler of a client (IO completions, timers, callbacks)
+ * runs through a per-client strand, so one io_context may be run by any
+ * number of threads and shared by many clients. Callbacks of one client never
+ * run concurrently with each other but may run on any thread calling
+ * ioContext.run().
+ *
+ * - connect(), disconnect() and send() are safe to call from any thread.
+ * - state() / isConnected() and the stats accessors may be read from any thread.
+ * - Setters (callbacks and configs) are not synchronized: call them before
+ *   connect() or from inside a callback of the same client.
+ *
+ * The asyncConnect() / asyncSend() / asyncReceive() operations take any Asio
+ * completion token and are thread-safe as well. With C++20 coroutines the
+ * default token is asio::use_awaitable, so `co_await client->asyncSend(msg)`
+ * works directly (errors are thrown as boost::system::system_error).
  */
-class TcpClient : public std::enable_shared_from_this<TcpClient> {
+template <typename Framing>
+class BasicTcpClient : public std::enable_shared_from_this<BasicTcpClient<Framing>> {
 public:
+    using FramingPolicy = Framing;
+
     // Callback type definitions
     using ConnectedCallback = std::function<void()>;
     using DisconnectedCallback = std::function<void()>;
-    using MessageCallback = std::function<void(const Message&)>;
+    // The message is borrowed: its body goes back to the buffer pool when the
+    // callback returns. Take a Message& and move the body out to retain it.
+    using MessageCallback = std::function<void(Message&)>;
+    // The view points into the receive buffer and is valid only during the callback
+    using MessageViewCallback = std::function<void(const MessageView&)>;
+    // Every frame parsed from one receive, same lifetime as MessageViewCallback
+    using MessageBatchCallback = std::function<void(const MessageBatch&)>;
     using ErrorCallback = std::function<void(const boost::system::error_code&)>;
+    // Written (bytes including the header) or dropped (error, 0 bytes)
+    using SendCallback = std::function<void(boost::system::error_code, size_t)>;
+    using BackpressureCallback = std::function<void(size_t queuedBytes)>;
+    using WritableCallback = std::function<void()>;
+    using StatsCallback = std::function<void(const ClientStats&)>;
+    // Runs on DispatchConfig::executor; the messages may be moved out
+    using DispatchCallback = std::function<void(std::vector<Message>&)>;
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+    using DefaultCompletionToken = asio::use_awaitable_t<>;
+#else
+    using DefaultCompletionToken = asio::default_completion_token_t<asio::any_io_executor>;
+#endif
 
-    explicit TcpClient(asio::io_context& ioContext);
-    ~TcpClient();
+    explicit BasicTcpClient(asio::io_context& ioContext);
+    ~BasicTcpClient();
 
     // Non-copyable
-    TcpClient(const TcpClient&) = delete;
-    TcpClient& operator=(const TcpClient&) = delete;
+    BasicTcpClient(const BasicTcpClient&) = delete;
+    BasicTcpClient& operator=(const BasicTcpClient&) = delete;
 
     // Connection management
     void connect(const std::string& host, uint16_t port);
     void disconnect();
 
-    // Message sending (thread-safe)
-    void send(const Message& message);
-    void send(const std::string& data);
+    // Message sending (thread-safe); false if rejected by BackpressurePolicy::Reject
+    // or larger than the framing's kMaxBodySize
+    bool send(const Message& message);
+    bool send(Message&& message);                           // Takes over the body, no copy
+    bool send(const std::string& data);
+    bool send(std::shared_ptr<const std::vector<char>> body); // Shares the body, no copy
+
+    /**
+     * @brief send(Message&&) for messages that must not be resent
+     *
+     * If the connection is lost before the frame is fully written, the frame
+     * is dropped instead of being replayed on the next connection, whatever
+     * the ReplayPolicy; it is never spilled or retained for acknowledge().
+     * onComplete runs on the client's strand once the frame is written or
+     * dropped, e.g. to fail the request it carries (RpcClient). Not called if
+     * this returns false.
+     */
+    bool sendNoReplay(Message&& message, SendCallback onComplete = nullptr);
+
+    /**
+     * @brief Send a file range as one frame: a length header, then the bytes
+     *        straight from the page cache (thread-safe)
+     *
+     * The body goes out with sendfile() on Linux over plain TCP and through a
+     * pread() bounce buffer otherwise (TLS, other systems); it is never copied
+     * into a Message. The file is opened (or fd dup()ed) here and read when
+     * the frame is written, so it must not shrink in between.
+     * @param length Bytes to send, 0 = to the end of the file
+     * @return false if the file cannot be opened (POSIX only), the range
+     *         exceeds the framing's kMaxBodySize, or the send is rejected
+     */
+    bool sendFile(const std::string& path, uint64_t offset = 0, uint64_t length = 0);
+    bool sendFile(int fd, uint64_t offset = 0, uint64_t length = 0);
+
+    // Write out everything queued so far without waiting for the cork policy (thread-safe)
+    void flush();
+
+    /**
+     * @brief Ack hook for ReplayPolicy::AtLeastOnce (thread-safe)
+     * @param frames Number of written frames, oldest first, the peer has confirmed
+     *
+     * Releases the frames and completes their asyncSend() handlers. Call it
+     * from onMessage when the protocol's ack arrives.
+     */
+    void acknowledge(size_t frames = 1);
+
+    /**
+     * @brief Connect and complete once connected
+     *
+     * Signature void(error_code). Fails when the client gives up (reconnect
+     * disabled or maxRetries reached) and with operation_aborted on disconnect().
+     * Also enables the asyncReceive() queue so no message is lost in between.
+     */
+    template <typename CompletionToken = DefaultCompletionToken>
+    auto asyncConnect(const std::string& host, uint16_t port,
+                      CompletionToken&& token = DefaultCompletionToken()) {
+        return asio::async_initiate<CompletionToken, void(boost::system::error_code)>(
+            [this](auto handler, const std::string& host, uint16_t port) {
+                connectAsync(host, port, bindCompletion<boost::system::error_code>(
+                                             std::move(handler), strand_));
+            },
+            token, host, port);
+    }
+
+    /**
+     * @brief Queue a message and complete once it has been written to the socket
+     *
+     * Signature void(error_code, size_t bytes), bytes including the header.
+     * Fails with no_buffer_space when rejected or dropped by the backpressure
+     * policy, message_size when the body exceeds the framing's kMaxBodySize,
+     * and with operation_aborted if the client is destroyed first.
+     */
+    template <typename CompletionToken = DefaultCompletionToken>
+    auto asyncSend(Message message, CompletionToken&& token = DefaultCompletionToken()) {
+        return asio::async_initiate<CompletionToken, void(boost::system::error_code, size_t)>(
+            [this](auto handler, Message&& message) {
+                sendAsync(std::move(message), bindCompletion<boost::system::error_code, size_t>(
+                                                  std::move(handler), strand_));
+            },
+            token, std::move(message));
+    }
+
+    /**
+     * @brief Receive the next message not taken by setOnMessage / setOnMessageView /
+     *        setOnMessageBatch
+     *
+     * Signature void(error_code, Message). Messages arriving with no receive
+     * pending are queued (see ReadConfig::maxReceiveQueue). Fails with the
+     * connection error if the connection drops while waiting, not_connected
+     * when disconnected with nothing queued, operation_aborted on disconnect().
+     */
+    template <typename CompletionToken = DefaultCompletionToken>
+    auto asyncReceive(CompletionToken&& token = DefaultCompletionToken()) {
+        return asio::async_initiate<CompletionToken, void(boost::system::error_code, Message)>(
+            [this](auto handler) {
+                receiveAsync(bindCompletion<boost::system::error_code, Message>(
+                    std::move(handler), strand_));
+            },
+            token);
+    }
 
     // State query
     ClientState state() const { return state_; }
     bool isConnected() const { return state_ == ClientState::Connected; }
 
+    // Write queue depth (sent but not yet written)
+    size_t queuedBytes() const { return queuedBytes_.load(std::memory_order_relaxed); }
+    size_t queuedMessages() const { return queuedMessages_.load(std::memory_order_relaxed); }
+
     // Reconnect configuration
     void setReconnectConfig(const ReconnectConfig& config) { reconnectConfig_ = config; }
     const ReconnectConfig& reconnectConfig() const { return reconnectConfig_; }
 
+    // Write configuration
+    void setWriteConfig(const WriteConfig& config) { writeConfig_ = config; }
+    const WriteConfig& writeConfig() const { return writeConfig_; }
+
+    // Send pacing (configure before connect)
+    void setPacingConfig(const PacingConfig& config);
+    const PacingConfig& pacingConfig() const { return pacingConfig_; }
+
+    // Connect configuration (strategy and per-attempt timeout)
+    void setConnectConfig(const ConnectConfig& config) { connectConfig_ = config; }
+    const ConnectConfig& connectConfig() const { return connectConfig_; }
+
+    // Socket tuning (takes effect on the next connect, reapplied on every reconnect)
+    void setSocketConfig(const SocketConfig& config) { socketConfig_ = config; }
+    const SocketConfig& socketConfig() const { return socketConfig_; }
+
+    // Read configuration (takes effect on the next connect)
+    void setReadConfig(const ReadConfig& config) { readConfig_ = config; }
+    const ReadConfig& readConfig() const { return readConfig_; }
+
+    // Off-strand message dispatch (configure before connect). false if the mode
+    // lacks its ring / executor (or maxBatch is 0): the client stays Inline
+    bool setDispatchConfig(const DispatchConfig& config);
+    const DispatchConfig& dispatchConfig() const { return dispatchConfig_; }
+
+    // Timeout configuration (takes effect on the next connect)
+    void setTimeoutConfig(const TimeoutConfig& config) { timeoutConfig_ = config; }
+    const TimeoutConfig& timeoutConfig() const { return timeoutConfig_; }
+
+    // Compression (configure before connect); compressed frames are rejected while codec is None
+    void setCompressionConfig(const CompressionConfig& config) { codec_.configure(config); }
+    const CompressionConfig& compressionConfig() const { return codec_.config(); }
+
+#if defined(ASIOCLIENT_HAS_TLS)
+    // TLS over the connection (nullptr = plain TCP); share one context across clients
+    void setTlsContext(TlsContextPtr context) { tlsContext_ = std::move(context); }
+    const TlsContextPtr& tlsContext() const { return tlsContext_; }
+#endif
+
+    // Heartbeat and TCP keepalive configuration (take effect on the next connect)
+    void setHeartbeatConfig(const HeartbeatConfig& config) { heartbeatConfig_ = config; }
+    const HeartbeatConfig& heartbeatConfig() const { return heartbeatConfig_; }
+    void setTcpKeepaliveConfig(const TcpKeepaliveConfig& config) { tcpKeepaliveConfig_ = config; }
+    const TcpKeepaliveConfig& tcpKeepaliveConfig() const { return tcpKeepaliveConfig_; }
+
+    // Replay policy and spill file (configure before connect)
+    void setReplayConfig(const ReplayConfig& config) { replayConfig_ = config; }
+    const ReplayConfig& replayConfig() const { return replayConfig_; }
+
+    // Instrumentation (configure before connect; stats() may be called from any thread)
+    void setStatsConfig(const StatsConfig& config) { statsConfig_ = config; }
+    const StatsConfig& statsConfig() const { return statsConfig_; }
+    ClientStats stats() const;
+
+    // Receive buffer pool (configure before connect)
+    void setBufferPoolConfig(const BufferPoolConfig& config) { bufferPool_.configure(config); }
+    const BufferPoolConfig& bufferPoolConfig() const { return bufferPool_.config(); }
+    BufferPoolStats bufferPoolStats() const { return bufferPool_.stats(); }
+
     // Callback setters
     void setOnConnected(ConnectedCallback cb) { onConnected_ = std::move(cb); }
     void setOnDisconnected(DisconnectedCallback cb) { onDisconnected_ = std::move(cb); }
     void setOnMessage(MessageCallback cb) { onMessage_ = std::move(cb); }
+    void setOnMessageView(MessageViewCallback cb) { onMessageView_ = std::move(cb); }
+    // Takes the place of onMessage / onMessageView; one call per read-ahead
+    // recv, a batch of one per frame otherwise
+    void setOnMessageBatch(MessageBatchCallback cb) { onMessageBatch_ = std::move(cb); }
     void setOnError(ErrorCallback cb) { onError_ = std::move(cb); }
+    void setOnBackpressure(BackpressureCallback cb) { onBackpressure_ = std::move(cb); }
+    void setOnWritable(WritableCallback cb) { onWritable_ = std::move(cb); }
+    void setOnStats(StatsCallback cb) { onStats_ = std::move(cb); }  // Every StatsConfig::reportInterval
+    void setOnDispatch(DispatchCallback cb) { onDispatch_ = std::move(cb); }  // DispatchMode::Executor
 
 private:
+    // Type-erased completion handlers of the async operations
+    using ConnectHandler = std::function<void(boost::system::error_code)>;
+    using SendHandler = std::function<void(boost::system::error_code, size_t)>;
+    using ReceiveHandler = std::function<void(boost::system::error_code, Message)>;
+
+    /**
+     * @brief Outbound frame: the length header is kept as its own small buffer
+     *        and written together with the body as a gather pair
+     *
+     * The header is right-aligned in bytes so that it ends where an inline
+     * body begins: a small frame is one contiguous buffer.
+     */
+    struct OutboundFrame {
+        std::array<char, Framing::kMaxHeaderSize + INLINE_BODY_SIZE> bytes;  // Header, then inline body
+        uint8_t headerSize = 0;                           // Bytes of header in use
+        uint8_t inlineSize = 0;                           // Body bytes after the header (no owned/shared)
+        std::vector<char> owned;                          // Body owned by the frame
+        std::shared_ptr<const std::vector<char>> shared;  // Body shared with the caller
+        FileBodyPtr file;                                 // sendFile(): body read from the file
+        StatsCounters::Clock::time_point enqueuedAt;      // For send latency (stats enabled)
+        SendHandler completion;                           // asyncSend() / sendNoReplay() only
+        bool pooled = false;                              // owned came from bufferPool_ (compressed)
+        bool heartbeat = false;                           // Never spilled or retained for replay
+        bool noReplay = false;                            // sendNoReplay(): dropped when the connection is lost
+
+        char* header() { return bytes.data() + Framing::kMaxHeaderSize - headerSize; }
+        const char* header() const { return bytes.data() + Framing::kMaxHeaderSize - headerSize; }
+        void setHeader(size_t bodyBytes, bool compressed) {
+            char encoded[Framing::kMaxHeaderSize];
+            setHeader(encoded, Framing::encode(bodyBytes, compressed, encoded));
+        }
+        void setHeader(const char* data, size_t length) {
+            headerSize = static_cast<uint8_t>(length);
+            std::memcpy(header(), data, length);
+        }
+        void setBody(const char* data, size_t length) {
+            if (length <= INLINE_BODY_SIZE) {
+                std::memcpy(bytes.data() + Framing::kMaxHeaderSize, data, length);
+                inlineSize = static_cast<uint8_t>(length);
+            } else {
+                owned.assign(data, data + length);
+            }
+        }
+        void setBody(Message&& message) {
+            if (message.isInline()) {
+                setBody(message.data(), message.bodySize());
+            } else {
+                owned = std::move(message.body());
+            }
+        }
+
+        bool inlineBody() const { return !shared && owned.empty(); }
+        std::string_view body() const {
+            if (shared) {
+                return std::string_view(shared->data(), shared->size());
+            }
+            if (!owned.empty()) {
+                return std::string_view(owned.data(), owned.size());
+            }
+            return std::string_view(bytes.data() + Framing::kMaxHeaderSize, inlineSize);
+        }
+        size_t bodySize() const { return body().size() + (file ? static_cast<size_t>(file->length()) : 0); }
+        size_t size() const { return headerSize + bodySize(); }
+    };
+
+    // Keeps the deque's freed buffers: a FIFO of small frames otherwise
+    // allocates one every few frames
+    using FrameQueue = std::deque<OutboundFrame, RecyclingAllocator<OutboundFrame>>;
+
+    // Memory the kernel may still read after a MSG_ZEROCOPY send returned
+    struct ZeroCopyPin {
+        uint32_t id;                                      // Completion ID of the send
+        std::shared_ptr<const std::vector<char>> header;  // The frame's slot in writeQueue_ is reused
+        std::shared_ptr<const std::vector<char>> body;
+    };
+
+    bool admit(size_t frameSize);
+    bool sendFileBody(FileBodyPtr file);
+    void enqueue(OutboundFrame&& frame);
+    void signalBackpressure();
+    void dropOldest();
+    void onDequeued(size_t frames, size_t bytes);
+    void scheduleDrain();
+    void drainOutbox();
+    void pullOutbox();
+    void compressFrame(OutboundFrame& frame);
+    void queueFrame(OutboundFrame&& frame);
+    bool spillFrame(OutboundFrame& frame);
+    void refillFromSpill();
+    void replayQueued(const boost::system::error_code& ec);
+    void dropQueued(const boost::system::error_code& ec, size_t& frames, size_t& bytes);
+    void dropUnreplayable(FrameQueue& queue, const boost::system::error_code& ec, size_t& frames, size_t& bytes);
+    void releaseFrame(OutboundFrame& frame, const boost::system::error_code& ec);
+    void writeIfReady();
+    void armCork();
+    void cancelCork();
+    void pacingBudget(double& bytes, double& messages) const;
+    std::chrono::nanoseconds reservePacing(size_t bytes, size_t messages);
+    void armPacing(std::chrono::nanoseconds delay);
+    void failPendingSends(const boost::system::error_code& ec);
+
+    // Async operation back ends (thread-safe)
+    void connectAsync(const std::string& host, uint16_t port, ConnectHandler handler);
+    void sendAsync(Message&& message, SendHandler handler);
+    void receiveAsync(ReceiveHandler handler);
+    void completeConnectWaiters(const boost::system::error_code& ec);
+    void failReceiveWaiters(const boost::system::error_code& ec);
+    void queueReceived(Message&& message);
+    bool receiveQueueFull() const;
+    bool deliveryBlocked() const;
+    void resumeReading();
+
     // Async operation methods
-    void doConnect();
+    void startConnect(const std::string& host, uint16_t port);
+    void doConnect(const asio::ip::tcp::resolver::results_type& endpoints);
     void doResolve();
-    void doReadHeader();
-    void doReadBody(uint32_t bodyLen);
+    void startReading();
+    void doReadHeader(size_t received = 0);  // received: header bytes already in headerBuffer_
+    void doReadBody(size_t bodyLen, bool compressed);
+    void continueReadHeader();
+    void doReadSome();
+    bool parseFrames();
+    bool isValidFrame(const FrameHeader& header) const;
+    void deliverFrame(const char* body, size_t len);
+    void deliverFrame(std::vector<char>&& body);
+    bool deliverCompressed(const char* data, size_t len);
+    Message adoptBody(std::vector<char>&& body);
+    bool flushBatch();
+    void dispatchMessage(Message&& message);
+    void postDispatchBatch();
+    void armDispatchRetry();
     void doWrite();
+    void startWrite();
+    void handleWrite(const boost::system::error_code& ec);
+    void completeWrite(const boost::system::error_code& ec);
+    bool wantsZeroCopy(const OutboundFrame& frame) const;
+    void writeZeroCopy(size_t offset);
+    void writeFileBody(uint64_t position);
+    void armZeroCopyCompletions();
+    void releaseZeroCopy();
     void doReconnect();
+    void doDisconnect();
 
     void handleConnect(const boost::system::error_code& ec);
-    void handleDisconnect();
+#if defined(ASIOCLIENT_HAS_TLS)
+    void startHandshake();
+    void checkHandshake(uint64_t connection);
+#endif
+    void handleDisconnect(const boost::system::error_code& ec);
+    void applyTcpKeepalive();
+    void applySocketOptions();
+    void rearmQuickAck();
+    void armReadIdle(std::chrono::nanoseconds delay);
+    void armWriteStall(std::chrono::nanoseconds delay);
+    void checkReadIdle(uint64_t connection);
+    void checkWriteStall(uint64_t connection);
+    void armHeartbeat(std::chrono::nanoseconds delay);
+    void checkHeartbeat(uint64_t connection);
+    void sendHeartbeat();
+    void cancelTimeouts();
     void resetReconnectState();
+    void startConnectAttempt();
+    void scheduleStatsReport();
     std::chrono::milliseconds calculateReconnectDelay();
 
     // Core components
     asio::io_context& ioContext_;
-    asio::ip::tcp::socket socket_;
+    asio::strand<asio::io_context::executor_type> strand_;  // Serializes all handlers of this client
+    Transport transport_;                                   // IO objects are bound to strand_
     asio::ip::tcp::resolver resolver_;
     asio::steady_timer reconnectTimer_;
+    asio::steady_timer statsTimer_;
+    asio::steady_timer corkTimer_;
+    asio::steady_timer paceTimer_;                          // Pacing: holds the built batch until its tokens accrue
+    asio::steady_timer dispatchTimer_;                      // Ring full: retries ringPending_
+    std::shared_ptr<Connector> connector_;                  // Connect operation in progress
+    TimerWheelPtr timerWheel_;                              // Shared by the io_context
 
     // Connection info (for reconnect)
     std::string host_;
     uint16_t port_;
 
+    // Resolved endpoint cache (reused across reconnects for dnsCacheTtl, dropped when a connect fails)
+    asio::ip::tcp::resolver::results_type resolvedEndpoints_;
+    std::chrono::steady_clock::time_point resolvedAt_;
+
     // Buffers
-    std::array<char, HEADER_SIZE> headerBuffer_;
+    std::array<char, Framing::kMaxHeaderSize> headerBuffer_;
     std::vector<char> bodyBuffer_;
-    std::queue<std::vector<char>> writeQueue_;
-    std::mutex writeMutex_;
+    std::vector<char> readBuffer_;                 // Read-ahead buffer: [readStart_, readEnd_) is unparsed
+    size_t readStart_{0};
+    size_t readEnd_{0};
+    BufferPool bufferPool_;                        // Recycles received message bodies
+    std::vector<MessageView> batchViews_;          // Frames collected for onMessageBatch_
+    std::vector<std::vector<char>> batchBodies_;   // Pooled bodies behind batchViews_ (not in readBuffer_)
+    FrameCodec codec_;                             // Compression contexts (strand only)
+    MpscQueue<OutboundFrame> outbox_;              // Filled by send() on any thread
+    std::atomic<bool> drainScheduled_{false};      // A drainOutbox() is posted and not yet run
+    FrameQueue writeQueue_;                        // IO thread only; front entries stay in place while being written
+    std::vector<asio::const_buffer> writeBuffers_; // Gather list of the write in progress
+    size_t writeBatchCount_{0};                    // Frames covered by the write in progress
+    size_t writeBatchBytes_{0};                    // Bytes covered by the write in progress
+    size_t writeQueueBytes_{0};                    // Bytes of the frames in writeQueue_ (dropped ones excluded)
+    size_t writeDropped_{0};                       // DropOldest: released frames right behind the write in progress
+    std::vector<char> corkBuffer_;                 // Cork mode: coalesced frames of the write in progress
+    bool corkArmed_{false};                        // corkTimer_ is waiting
+    uint64_t corkGeneration_{0};                   // Invalidates a cork deadline already expired
+    bool flushRequested_{false};                   // flush() or cork deadline: write regardless of size
+    TokenBucketPtr paceBytes_;                     // Per-client buckets from pacingConfig_ (null = unlimited)
+    TokenBucketPtr paceMessages_;
+    bool pacing_{false};                           // Some bucket applies
+    bool paceWaiting_{false};                      // paceTimer_ holds the write in progress
+    std::atomic<size_t> queuedBytes_{0};           // Bytes in outbox_, writeQueue_, unacked_ and the spill
+    std::atomic<size_t> queuedMessages_{0};        // Frames in outbox_, writeQueue_, unacked_ and the spill
+    std::atomic<bool> aboveHighWatermark_{false};  // onBackpressure fired, onWritable pending
+
+    // Kernel zero-copy writes (strand only)
+    bool zeroCopy_{false};                         // SO_ZEROCOPY is on for this connection
+    bool zeroCopyWaiting_{false};                  // Error queue wait outstanding
+    uint32_t zeroCopyNextId_{0};                   // Completion ID of the next MSG_ZEROCOPY send
+    std::deque<ZeroCopyPin> zeroCopyPinned_;       // Oldest completion ID first
+    std::shared_ptr<const std::vector<char>> zeroCopyHeader_;  // Header copy of the frame being sent
+    std::vector<char> fileChunk_;                  // sendFile() bounce buffer (no sendfile())
+
+    // Replay and spill state (strand only); the queue order is
+    // writeQueue_ -> spill_ -> spillOverflow_
+    FrameQueue unacked_;                           // AtLeastOnce: written, waiting for acknowledge()
+    SpillFile spill_;
+    size_t spilledBytes_{0};                       // Frame bytes in spill_
+    uint64_t spillPushed_{0};                      // Records ever spilled (sequence of the next one)
+    uint64_t spillPopped_{0};
+    std::deque<std::pair<uint64_t, SendHandler>> spillCompletions_;  // asyncSend() handlers of spilled frames
+    FrameQueue spillOverflow_;                     // Spill file full: queued behind it in memory
+    bool spillFailed_{false};                      // The file could not be opened, stay in memory
+
+    // Async operation state (strand only)
+    std::vector<ConnectHandler> connectWaiters_;   // asyncConnect() calls waiting for Connected
+    std::deque<ReceiveHandler> receiveWaiters_;    // asyncReceive() calls waiting for a message
+    std::deque<Message> receiveQueue_;             // Messages waiting for asyncReceive()
+    bool receiveQueueEnabled_{false};              // Set by the first asyncConnect() / asyncReceive()
+    bool readPaused_{false};                       // Receive queue full, no read outstanding
+
+    // Off-strand dispatch (strand only, except dispatchInFlight_)
+    std::deque<Message> ringPending_;              // Parsed while the ring was full
+    bool dispatchRetryArmed_{false};
+    std::vector<Message> dispatchBatch_;           // Executor: batch being built
+    std::atomic<size_t> dispatchInFlight_{0};      // Executor: batches posted and not yet handled
+
+    // Liveness timeouts and heartbeat (strand only)
+    uint64_t connectionId_{0};                     // Bumped per connection; stale checks compare it
+    TimerWheel::TimerId readIdleTimer_{0};
+    TimerWheel::TimerId writeStallTimer_{0};
+    TimerWheel::TimerId heartbeatTimer_{0};
+    TimerWheel::TimerId handshakeTimer_{0};
+    bool handshakeTimedOut_{false};
+    bool trackReads_{false};                       // Some check needs lastReadAt_
+    StatsCounters::Clock::time_point lastReadAt_;
+    StatsCounters::Clock::time_point lastWriteAt_; // Last doWrite() (heartbeat enabled)
+    StatsCounters::Clock::time_point writeStartedAt_;
+
+    // Instrumentation
+    StatsConfig statsConfig_;
+    StatsCounters stats_;
+    std::atomic<int64_t> drainPostedAt_{0};        // Clock ticks when the pending drain was posted
+    StatsCounters::Clock::time_point connectStartedAt_;
 
     // State management
     std::atomic<ClientState> state_{ClientState::Disconnected};
     ReconnectConfig reconnectConfig_;
+    ConnectConfig connectConfig_;
+    SocketConfig socketConfig_;
+    WriteConfig writeConfig_;
+    PacingConfig pacingConfig_;
+    ReadConfig readConfig_;
+    DispatchConfig dispatchConfig_;
+    TimeoutConfig timeoutConfig_;
+    HeartbeatConfig heartbeatConfig_;
+    TcpKeepaliveConfig tcpKeepaliveConfig_;
+    ReplayConfig replayConfig_;
+#if defined(ASIOCLIENT_HAS_TLS)
+    TlsContextPtr tlsContext_;
+#endif
     int reconnectAttempts_{0};
+    std::chrono::milliseconds lastReconnectDelay_{0};      // Previous delay, for decorrelated jitter
+    std::minstd_rand jitterRng_;
     std::atomic<bool> userDisconnect_{false};
 
     // Callbacks
     ConnectedCallback onConnected_;
     DisconnectedCallback onDisconnected_;
     MessageCallback onMessage_;
+    MessageViewCallback onMessageView_;
+    MessageBatchCallback onMessageBatch_;
     ErrorCallback onError_;
+    BackpressureCallback onBackpressure_;
+    WritableCallback onWritable_;
+    StatsCallback onStats_;
+    DispatchCallback onDispatch_;
 };
 
+// Compiled once in TcpClient.cpp; other policies need TcpClient.ipp
+extern template class BasicTcpClient<BigEndian32Framing<>>;
+extern template class BasicTcpClient<BigEndian16Framing<>>;
+extern template class BasicTcpClient<LittleEndian64Framing<>>;
+extern template class BasicTcpClient<VarintFraming<>>;
+
+using TcpClient = BasicTcpClient<DefaultFraming>;
 using TcpClientPtr = std::shared_ptr<TcpClient>;
 
+template <typename Framing>
+using BasicTcpClientPtr = std::shared_ptr<BasicTcpClient<Framing>>;
+
 /**
  * @brief Factory function to create TcpClient instance
+ * @tparam Framing Length-prefix policy, the default protocol if omitted
  * @param ioContext IO context
- * @return Shared pointer to TcpClient
+ * @return Shared pointer to the client
  */
-inline TcpClientPtr createClient(asio::io_context& ioContext) {
-    return std::make_shared<TcpClient>(ioContext);
+template <typename Framing = DefaultFraming>
+inline BasicTcpClientPtr<Framing> createClient(asio::io_context& ioContext) {
+    return std::make_shared<BasicTcpClient<Framing>>(ioContext);
 }
 
 } // namespace asioclient
@@ -0,0 +1,2340 @@
+/**
+ * @file TcpClient.ipp
+ * @brief BasicTcpClient implementation
+ *
+ * Instantiated for the bundled framing policies in TcpClient.cpp; include it
+ * in one translation unit to instantiate BasicTcpClient with a custom one.
+ */
+#pragma once
+
+#include "TcpClient.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace asioclient {
+
+namespace detail {
+
+/**
+ * @brief Integer socket option for socket::set_option (keepalive timing, Linux tuning)
+ */
+class IntSocketOption {
+public:
+    IntSocketOption(int level, int name, int value) : level_(level), name_(name), value_(value) {}
+
+    template <typename Protocol> int level(const Protocol&) const { return level_; }
+    template <typename Protocol> int name(const Protocol&) const { return name_; }
+    template <typename Protocol> const int* data(const Protocol&) const { return &value_; }
+    template <typename Protocol> std::size_t size(const Protocol&) const { return sizeof(value_); }
+
+private:
+    int level_;
+    int name_;
+    int value_;
+};
+
+} // namespace detail
+
+template <typename Framing>
+BasicTcpClient<Framing>::BasicTcpClient(asio::io_context& ioContext)
+    : ioContext_(ioContext)
+    , strand_(asio::make_strand(ioContext))
+    , transport_(strand_)
+    , resolver_(strand_)
+    , reconnectTimer_(strand_)
+    , statsTimer_(strand_)
+    , corkTimer_(strand_)
+    , paceTimer_(strand_)
+    , dispatchTimer_(strand_)
+    , timerWheel_(TimerWheel::forContext(ioContext))
+    , port_(0)
+    , jitterRng_(std::random_device{}() ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this)))
+{
+}
+
+template <typename Framing>
+BasicTcpClient<Framing>::~BasicTcpClient() {
+    // Every pending handler holds a shared_ptr, so none can be running here
+    doDisconnect();
+    failPendingSends(asio::error::operation_aborted);
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::connect(const std::string& host, uint16_t port) {
+    auto self = this->shared_from_this();
+
+    asio::dispatch(strand_, [this, self, host, port]() {
+        startConnect(host, port);
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::startConnect(const std::string& host, uint16_t port) {
+    if (host != host_ || port != port_) {
+        resolvedEndpoints_ = asio::ip::tcp::resolver::results_type();
+    }
+    host_ = host;
+    port_ = port;
+    userDisconnect_ = false;
+    resetReconnectState();
+    state_ = ClientState::Connecting;
+    scheduleStatsReport();
+    startConnectAttempt();
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::disconnect() {
+    // Set immediately so no reconnect is scheduled in the meantime
+    userDisconnect_ = true;
+
+    auto self = this->shared_from_this();
+    asio::dispatch(strand_, [this, self]() {
+        doDisconnect();
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::doDisconnect() {
+    if (state_ == ClientState::Connected && statsConfig_.enabled) {
+        StatsCounters::add(stats_.disconnects);
+    }
+
+    userDisconnect_ = true;
+    reconnectTimer_.cancel();
+    statsTimer_.cancel();
+    dispatchTimer_.cancel();
+    paceTimer_.cancel();
+    cancelCork();
+    cancelTimeouts();
+    resolver_.cancel();
+    if (connector_) {
+        connector_->cancel();
+        connector_.reset();
+    }
+
+    boost::system::error_code ec;
+    transport_.close(ec);
+    releaseZeroCopy();
+    replayQueued(asio::error::operation_aborted);
+
+    state_ = ClientState::Disconnected;
+    completeConnectWaiters(asio::error::operation_aborted);
+    failReceiveWaiters(asio::error::operation_aborted);
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::send(const Message& message) {
+    if (!admit(Framing::kMaxHeaderSize + message.bodySize())) {
+        return false;
+    }
+
+    OutboundFrame frame;
+    frame.setBody(message.data(), message.bodySize());
+    enqueue(std::move(frame));
+    return true;
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::send(Message&& message) {
+    if (!admit(Framing::kMaxHeaderSize + message.bodySize())) {
+        return false;
+    }
+
+    OutboundFrame frame;
+    frame.setBody(std::move(message));
+    enqueue(std::move(frame));
+    return true;
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::sendNoReplay(Message&& message, SendCallback onComplete) {
+    if (!admit(Framing::kMaxHeaderSize + message.bodySize())) {
+        return false;
+    }
+
+    OutboundFrame frame;
+    frame.setBody(std::move(message));
+    frame.noReplay = true;
+    frame.completion = std::move(onComplete);
+    enqueue(std::move(frame));
+    return true;
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::send(const std::string& data) {
+    if (!admit(Framing::kMaxHeaderSize + data.size())) {
+        return false;
+    }
+
+    OutboundFrame frame;
+    frame.setBody(data.data(), data.size());
+    enqueue(std::move(frame));
+    return true;
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::send(std::shared_ptr<const std::vector<char>> body) {
+    if (!admit(Framing::kMaxHeaderSize + (body ? body->size() : 0))) {
+        return false;
+    }
+
+    OutboundFrame frame;
+    frame.shared = body ? std::move(body) : std::make_shared<const std::vector<char>>();
+    enqueue(std::move(frame));
+    return true;
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::sendFile(const std::string& path, uint64_t offset, uint64_t length) {
+    auto file = std::make_shared<FileBody>();
+    boost::system::error_code ec;
+    if (!file->open(path, offset, length, ec)) {
+        return false;
+    }
+    return sendFileBody(std::move(file));
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::sendFile(int fd, uint64_t offset, uint64_t length) {
+    auto file = std::make_shared<FileBody>();
+    boost::system::error_code ec;
+    if (!file->open(fd, offset, length, ec)) {
+        return false;
+    }
+    return sendFileBody(std::move(file));
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::sendFileBody(FileBodyPtr file) {
+    if (file->length() > Framing::kMaxBodySize) {
+        if (statsConfig_.enabled) {
+            StatsCounters::add(stats_.messagesRejected);
+        }
+        return false;
+    }
+    if (!admit(Framing::kMaxHeaderSize + static_cast<size_t>(file->length()))) {
+        return false;
+    }
+
+    OutboundFrame frame;
+    frame.file = std::move(file);
+    enqueue(std::move(frame));
+    return true;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::flush() {
+    // Posted behind the drains of sends made before this call
+    auto self = this->shared_from_this();
+    asio::post(strand_, [this, self]() {
+        if (!writeQueue_.empty()) {
+            flushRequested_ = true;
+            writeIfReady();
+        }
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::acknowledge(size_t frames) {
+    auto self = this->shared_from_this();
+    asio::post(strand_, [this, self, frames]() {
+        size_t count = std::min(frames, unacked_.size());
+        size_t bytes = 0;
+        for (size_t i = 0; i < count; ++i) {
+            bytes += unacked_[i].size();
+            releaseFrame(unacked_[i], boost::system::error_code());
+        }
+        unacked_.erase(unacked_.begin(), unacked_.begin() + count);
+        onDequeued(count, bytes);
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::connectAsync(const std::string& host, uint16_t port, ConnectHandler handler) {
+    auto self = this->shared_from_this();
+
+    asio::dispatch(strand_, [this, self, host, port, handler = std::move(handler)]() mutable {
+        receiveQueueEnabled_ = true;
+        connectWaiters_.push_back(std::move(handler));
+        startConnect(host, port);
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::sendAsync(Message&& message, SendHandler handler) {
+    if (!admit(Framing::kMaxHeaderSize + message.bodySize())) {
+        handler(message.bodySize() > Framing::kMaxBodySize
+                    ? boost::system::errc::make_error_code(boost::system::errc::message_size)
+                    : boost::system::error_code(asio::error::no_buffer_space), 0);
+        return;
+    }
+
+    OutboundFrame frame;
+    frame.setBody(std::move(message));
+    frame.completion = std::move(handler);
+    enqueue(std::move(frame));
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::receiveAsync(ReceiveHandler handler) {
+    auto self = this->shared_from_this();
+
+    asio::dispatch(strand_, [this, self, handler = std::move(handler)]() mutable {
+        receiveQueueEnabled_ = true;
+
+        if (!receiveQueue_.empty()) {
+            Message message = std::move(receiveQueue_.front());
+            receiveQueue_.pop_front();
+            handler(boost::system::error_code(), std::move(message));
+
+            if (readPaused_ && !deliveryBlocked()) {
+                resumeReading();
+            }
+            return;
+        }
+
+        if (state_ == ClientState::Disconnected) {
+            handler(asio::error::not_connected, Message());
+            return;
+        }
+        receiveWaiters_.push_back(std::move(handler));
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::completeConnectWaiters(const boost::system::error_code& ec) {
+    auto waiters = std::move(connectWaiters_);
+    connectWaiters_.clear();
+    for (auto& waiter : waiters) {
+        waiter(ec);
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::failReceiveWaiters(const boost::system::error_code& ec) {
+    auto waiters = std::move(receiveWaiters_);
+    receiveWaiters_.clear();
+    for (auto& waiter : waiters) {
+        waiter(ec, Message());
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::queueReceived(Message&& message) {
+    if (!receiveWaiters_.empty()) {
+        ReceiveHandler waiter = std::move(receiveWaiters_.front());
+        receiveWaiters_.pop_front();
+        waiter(boost::system::error_code(), std::move(message));
+        return;
+    }
+    receiveQueue_.push_back(std::move(message));
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::receiveQueueFull() const {
+    return receiveQueue_.size() >= std::max<size_t>(readConfig_.maxReceiveQueue, 1);
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::deliveryBlocked() const {
+    switch (dispatchConfig_.mode) {
+    case DispatchMode::Ring:
+        return !ringPending_.empty();
+    case DispatchMode::Executor:
+        return dispatchInFlight_.load(std::memory_order_acquire) >=
+               std::max<size_t>(dispatchConfig_.maxPendingBatches, 1);
+    default:
+        return receiveQueueFull();
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::failPendingSends(const boost::system::error_code& ec) {
+    // Only called once no other thread can touch the queues
+    size_t frames = 0;
+    size_t bytes = 0;
+    dropQueued(ec, frames, bytes);
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::admit(size_t frameSize) {
+    // A length the framing cannot express would corrupt the stream
+    if (frameSize - Framing::kMaxHeaderSize > Framing::kMaxBodySize) {
+        if (statsConfig_.enabled) {
+            StatsCounters::add(stats_.messagesRejected);
+        }
+        return false;
+    }
+
+    if (writeConfig_.backpressure != BackpressurePolicy::Reject) {
+        return true;
+    }
+
+    // Checked before the body is copied, so a rejected send costs nothing
+    if (queuedBytes_.load(std::memory_order_relaxed) + frameSize > writeConfig_.highWatermark) {
+        if (statsConfig_.enabled) {
+            StatsCounters::add(stats_.messagesRejected);
+        }
+        signalBackpressure();
+        return false;
+    }
+    return true;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::enqueue(OutboundFrame&& frame) {
+    frame.setHeader(frame.bodySize(), false);
+
+    size_t queued = queuedBytes_.fetch_add(frame.size(), std::memory_order_relaxed) + frame.size();
+    size_t depth = queuedMessages_.fetch_add(1, std::memory_order_relaxed);
+    if (statsConfig_.enabled) {
+        stats_.queueDepth.record(depth);
+        frame.enqueuedAt = StatsCounters::Clock::now();
+    }
+    outbox_.push(std::move(frame));
+
+    if (writeConfig_.backpressure != BackpressurePolicy::None &&
+        queued > writeConfig_.highWatermark) {
+        signalBackpressure();
+    }
+    scheduleDrain();
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::signalBackpressure() {
+    // Fire once per excursion above the high watermark
+    if (aboveHighWatermark_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    auto self = this->shared_from_this();
+    asio::post(strand_, [this, self]() {
+        if (onBackpressure_) {
+            onBackpressure_(queuedBytes());
+        }
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::onDequeued(size_t frames, size_t bytes) {
+    size_t queued = queuedBytes_.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+    queuedMessages_.fetch_sub(frames, std::memory_order_relaxed);
+
+    if (queued <= writeConfig_.lowWatermark &&
+        aboveHighWatermark_.load(std::memory_order_relaxed) &&
+        aboveHighWatermark_.exchange(false, std::memory_order_acq_rel)) {
+        if (onWritable_) {
+            onWritable_();
+        }
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::dropOldest() {
+    // Frames covered by the write in progress must stay in place, and erasing
+    // from the middle of a deque may move them: behind a write, dropped frames
+    // are released now and erased from the front together with the batch
+    size_t first = writeBatchCount_ + writeDropped_;
+    size_t last = first;
+    size_t bytes = 0;
+    size_t queued = queuedBytes();
+
+    while (last < writeQueue_.size() && queued - bytes > writeConfig_.highWatermark) {
+        bytes += writeQueue_[last].size();
+        ++last;
+    }
+
+    if (last > first) {
+        for (size_t i = first; i < last; ++i) {
+            releaseFrame(writeQueue_[i], asio::error::no_buffer_space);
+        }
+        if (writeBatchCount_ == 0) {
+            writeQueue_.erase(writeQueue_.begin(), writeQueue_.begin() + last);
+        } else {
+            writeDropped_ += last - first;
+        }
+        writeQueueBytes_ -= bytes;
+        if (statsConfig_.enabled) {
+            StatsCounters::add(stats_.messagesDropped, last - first);
+        }
+        onDequeued(last - first, bytes);
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::scheduleDrain() {
+    // Only the send that finds no drain pending posts one, so a burst of sends
+    // from a producer thread costs a single handler dispatch
+    if (drainScheduled_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    if (statsConfig_.enabled) {
+        drainPostedAt_.store(StatsCounters::Clock::now().time_since_epoch().count(),
+                             std::memory_order_relaxed);
+    }
+
+    auto self = this->shared_from_this();
+    asio::post(strand_, [this, self]() {
+        drainOutbox();
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::drainOutbox() {
+    // Clear the flag before popping: a push that lands after this point
+    // either gets popped below or schedules another drain
+    drainScheduled_.exchange(false, std::memory_order_acq_rel);
+
+    if (statsConfig_.enabled) {
+        StatsCounters::Clock::time_point postedAt(StatsCounters::Clock::duration(
+            drainPostedAt_.load(std::memory_order_relaxed)));
+        stats_.dispatchLatency.record(StatsCounters::elapsedNs(postedAt));
+    }
+
+    pullOutbox();
+
+    // A producer is between linking and publishing its node; come back for it
+    if (outbox_.pending()) {
+        scheduleDrain();
+    }
+
+    if (writeConfig_.backpressure == BackpressurePolicy::DropOldest &&
+        queuedBytes() > writeConfig_.highWatermark) {
+        dropOldest();
+    }
+
+    writeIfReady();
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::pullOutbox() {
+    OutboundFrame frame;
+    while (outbox_.pop(frame)) {
+        if (Framing::kCompression && !frame.file && codec_.wants(frame.body().size())) {
+            compressFrame(frame);
+        }
+        queueFrame(std::move(frame));
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::compressFrame(OutboundFrame& frame) {
+    std::string_view body = frame.body();
+    std::vector<char> compressed = bufferPool_.acquire(body.size());
+    if (!codec_.compress(body.data(), body.size(), compressed)) {
+        bufferPool_.release(std::move(compressed));
+        return;
+    }
+
+    // queuedBytes_ was charged the plain size when the frame was enqueued
+    size_t saved = body.size() - compressed.size();
+    queuedBytes_.fetch_sub(saved, std::memory_order_relaxed);
+
+    if (!frame.shared) {
+        bufferPool_.release(std::move(frame.owned));
+    }
+    frame.shared.reset();
+    frame.owned = std::move(compressed);
+    frame.inlineSize = 0;
+    frame.pooled = true;
+    frame.setHeader(frame.owned.size(), true);
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::queueFrame(OutboundFrame&& frame) {
+    // Behind a full spill file: keep the order, stay in memory
+    if (!spillOverflow_.empty()) {
+        spillOverflow_.push_back(std::move(frame));
+        return;
+    }
+
+    bool spill = !replayConfig_.spillPath.empty() && !spillFailed_ && !frame.heartbeat && !frame.file &&
+                 !frame.noReplay &&
+                 (!spill_.empty() || queuedBytes() - spilledBytes_ > replayConfig_.spillThreshold);
+    if (spill) {
+        if (spillFrame(frame)) {
+            return;
+        }
+        if (!spillFailed_) {
+            spillOverflow_.push_back(std::move(frame));
+            return;
+        }
+    }
+    writeQueueBytes_ += frame.size();
+    writeQueue_.push_back(std::move(frame));
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::spillFrame(OutboundFrame& frame) {
+    if (!spill_.isOpen()) {
+        boost::system::error_code ec;
+        if (!spill_.open(replayConfig_.spillPath, replayConfig_.spillCapacity, ec)) {
+            spillFailed_ = true;
+            if (onError_) {
+                onError_(ec);
+            }
+            return false;
+        }
+    }
+
+    std::string_view body = frame.body();
+    if (!spill_.push(frame.enqueuedAt.time_since_epoch().count(),
+                     frame.header(), frame.headerSize,
+                     body.data(), body.size())) {
+        return false;
+    }
+
+    if (frame.completion) {
+        spillCompletions_.emplace_back(spillPushed_, std::move(frame.completion));
+    }
+    ++spillPushed_;
+    spilledBytes_ += frame.size();
+    if (frame.pooled) {
+        bufferPool_.release(std::move(frame.owned));
+    }
+    if (statsConfig_.enabled) {
+        StatsCounters::add(stats_.messagesSpilled);
+    }
+    return true;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::refillFromSpill() {
+    // Read back about half the memory budget in one go, at least one frame
+    size_t budget = std::max<size_t>(replayConfig_.spillThreshold / 2, 1);
+    size_t loaded = 0;
+
+    while (loaded < budget && !spill_.empty()) {
+        OutboundFrame frame;
+        int64_t stamp = 0;
+        char header[Framing::kMaxHeaderSize];
+        size_t headerSize = 0;
+        spill_.pop(stamp, header, headerSize, frame.owned);
+        frame.setHeader(header, headerSize);
+        frame.enqueuedAt = StatsCounters::Clock::time_point(StatsCounters::Clock::duration(stamp));
+        if (!spillCompletions_.empty() && spillCompletions_.front().first == spillPopped_) {
+            frame.completion = std::move(spillCompletions_.front().second);
+            spillCompletions_.pop_front();
+        }
+        ++spillPopped_;
+        spilledBytes_ -= frame.size();
+        loaded += frame.size();
+        writeQueueBytes_ += frame.size();
+        writeQueue_.push_back(std::move(frame));
+    }
+
+    // Frames held back by a full file follow the ones in it
+    while (!spillOverflow_.empty()) {
+        OutboundFrame& next = spillOverflow_.front();
+        if (spill_.empty() && loaded < budget) {
+            loaded += next.size();
+            writeQueueBytes_ += next.size();
+            writeQueue_.push_back(std::move(next));
+        } else if (!spillFrame(next)) {
+            break;
+        }
+        spillOverflow_.pop_front();
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::replayQueued(const boost::system::error_code& ec) {
+    // The framing restarts on the next connection: frames of a write that
+    // failed midway are resent whole, from the front of the queue
+    size_t inFlight = writeBatchCount_;
+    writeQueue_.erase(writeQueue_.begin() + inFlight,
+                      writeQueue_.begin() + inFlight + writeDropped_);
+    writeBatchCount_ = 0;
+    writeBatchBytes_ = 0;
+    writeDropped_ = 0;
+    paceWaiting_ = false;
+
+    size_t replayed = 0;
+    switch (replayConfig_.policy) {
+        case ReplayPolicy::Drop: {
+            size_t frames = 0;
+            size_t bytes = 0;
+            dropQueued(ec, frames, bytes);
+            if (statsConfig_.enabled) {
+                StatsCounters::add(stats_.messagesDropped, frames);
+            }
+            onDequeued(frames, bytes);
+            return;
+        }
+
+        case ReplayPolicy::AtLeastOnce:
+            // Written but unconfirmed frames go first, in their original order
+            replayed = unacked_.size() + inFlight;
+            for (const auto& frame : unacked_) {
+                writeQueueBytes_ += frame.size();
+            }
+            writeQueue_.insert(writeQueue_.begin(),
+                               std::make_move_iterator(unacked_.begin()),
+                               std::make_move_iterator(unacked_.end()));
+            unacked_.clear();
+            break;
+
+        case ReplayPolicy::RetryFromFront:
+        default:
+            replayed = inFlight;
+            break;
+    }
+
+    // sendNoReplay() frames never reach the next connection, including the
+    // ones still in the outbox
+    pullOutbox();
+    size_t frames = 0;
+    size_t bytes = 0;
+    dropUnreplayable(writeQueue_, ec, frames, bytes);
+    writeQueueBytes_ -= bytes;
+    dropUnreplayable(spillOverflow_, ec, frames, bytes);
+    if (frames > 0) {
+        if (statsConfig_.enabled) {
+            StatsCounters::add(stats_.messagesDropped, frames);
+        }
+        onDequeued(frames, bytes);
+    }
+
+    if (replayed > 0 && statsConfig_.enabled) {
+        StatsCounters::add(stats_.messagesReplayed, replayed);
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::dropUnreplayable(FrameQueue& queue, const boost::system::error_code& ec,
+                                               size_t& frames, size_t& bytes) {
+    if (std::none_of(queue.begin(), queue.end(), [](const OutboundFrame& frame) { return frame.noReplay; })) {
+        return;
+    }
+
+    // No write is in flight here, so the kept frames may move
+    FrameQueue kept;
+    for (auto& frame : queue) {
+        if (!frame.noReplay) {
+            kept.push_back(std::move(frame));
+            continue;
+        }
+        ++frames;
+        bytes += frame.size();
+        releaseFrame(frame, ec);
+    }
+    queue.swap(kept);
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::dropQueued(const boost::system::error_code& ec, size_t& frames, size_t& bytes) {
+    OutboundFrame frame;
+    while (outbox_.pop(frame)) {
+        writeQueue_.push_back(std::move(frame));
+    }
+
+    for (auto* queue : {&unacked_, &writeQueue_, &spillOverflow_}) {
+        for (auto& queued : *queue) {
+            ++frames;
+            bytes += queued.size();
+            releaseFrame(queued, ec);
+        }
+        queue->clear();
+    }
+    writeQueueBytes_ = 0;
+
+    frames += spill_.size();
+    bytes += spilledBytes_;
+    for (auto& completion : spillCompletions_) {
+        completion.second(ec, 0);
+    }
+    spillCompletions_.clear();
+    spill_.clear();
+    spilledBytes_ = 0;
+    spillPopped_ = spillPushed_;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::releaseFrame(OutboundFrame& frame, const boost::system::error_code& ec) {
+    if (frame.completion) {
+        frame.completion(ec, ec ? 0 : frame.size());
+    }
+    if (frame.pooled) {
+        bufferPool_.release(std::move(frame.owned));
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::writeIfReady() {
+    if (writeBatchCount_ == 0 && writeQueue_.empty() && isConnected() &&
+        (!spill_.empty() || !spillOverflow_.empty())) {
+        refillFromSpill();
+    }
+
+    if (writeBatchCount_ > 0 || writeQueue_.empty() || !isConnected()) {
+        return;
+    }
+
+    // Corked: hold small writes until the size or deadline policy says go.
+    // Only bytes waiting to be written count, not unacked or spilled ones
+    if (writeConfig_.cork && !flushRequested_ &&
+        writeQueueBytes_ - writeBatchBytes_ < writeConfig_.corkBytes) {
+        armCork();
+        return;
+    }
+    doWrite();
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::armCork() {
+    if (corkArmed_) {
+        return;
+    }
+    corkArmed_ = true;
+
+    auto self = this->shared_from_this();
+    uint64_t generation = ++corkGeneration_;
+    corkTimer_.expires_after(writeConfig_.corkDelay);
+    corkTimer_.async_wait([this, self, generation](const boost::system::error_code& ec) {
+        if (ec || generation != corkGeneration_) {
+            return;
+        }
+        corkArmed_ = false;
+        flushRequested_ = true;
+        writeIfReady();
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::cancelCork() {
+    if (corkArmed_) {
+        corkArmed_ = false;
+        ++corkGeneration_;
+        corkTimer_.cancel();
+    }
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::setDispatchConfig(const DispatchConfig& config) {
+    // A mode without its target would crash on the first frame received
+    bool valid = config.mode == DispatchMode::Inline ||
+                 (config.mode == DispatchMode::Ring && config.ring) ||
+                 (config.mode == DispatchMode::Executor && config.executor && config.maxBatch > 0);
+    dispatchConfig_ = config;
+    if (!valid) {
+        dispatchConfig_.mode = DispatchMode::Inline;
+    }
+    return valid;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::setPacingConfig(const PacingConfig& config) {
+    pacingConfig_ = config;
+    paceBytes_ = config.bytesPerSecond > 0
+        ? createTokenBucket(config.bytesPerSecond, static_cast<double>(config.burstBytes))
+        : nullptr;
+    paceMessages_ = config.messagesPerSecond > 0
+        ? createTokenBucket(config.messagesPerSecond, static_cast<double>(config.burstMessages))
+        : nullptr;
+    pacing_ = paceBytes_ || paceMessages_ || config.sharedBytes || config.sharedMessages;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::pacingBudget(double& bytes, double& messages) const {
+    bytes = std::numeric_limits<double>::infinity();
+    messages = std::numeric_limits<double>::infinity();
+    for (const TokenBucketPtr* bucket : {&paceBytes_, &pacingConfig_.sharedBytes}) {
+        if (*bucket && (*bucket)->rate() > 0) {
+            bytes = std::min(bytes, (*bucket)->available());
+        }
+    }
+    for (const TokenBucketPtr* bucket : {&paceMessages_, &pacingConfig_.sharedMessages}) {
+        if (*bucket && (*bucket)->rate() > 0) {
+            messages = std::min(messages, (*bucket)->available());
+        }
+    }
+}
+
+template <typename Framing>
+std::chrono::nanoseconds BasicTcpClient<Framing>::reservePacing(size_t bytes, size_t messages) {
+    // Every bucket is charged; the write waits for the slowest one
+    std::chrono::nanoseconds delay(0);
+    for (const TokenBucketPtr* bucket : {&paceBytes_, &pacingConfig_.sharedBytes}) {
+        if (*bucket) {
+            delay = std::max(delay, (*bucket)->reserve(static_cast<double>(bytes)));
+        }
+    }
+    for (const TokenBucketPtr* bucket : {&paceMessages_, &pacingConfig_.sharedMessages}) {
+        if (*bucket) {
+            delay = std::max(delay, (*bucket)->reserve(static_cast<double>(messages)));
+        }
+    }
+    return delay;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::armPacing(std::chrono::nanoseconds delay) {
+    paceWaiting_ = true;
+    if (statsConfig_.enabled) {
+        StatsCounters::add(stats_.pacedWrites);
+    }
+
+    auto self = this->shared_from_this();
+    uint64_t connection = connectionId_;
+    paceTimer_.expires_after(delay);
+    paceTimer_.async_wait([this, self, connection](const boost::system::error_code& ec) {
+        if (ec || connection != connectionId_ || !isConnected() || !paceWaiting_) {
+            return;
+        }
+        paceWaiting_ = false;
+        startWrite();
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::doResolve() {
+    auto self = this->shared_from_this();
+    connectStartedAt_ = StatsCounters::Clock::now();
+
+    // Reconnect storms reuse the cached endpoints instead of hitting DNS again
+    if (!resolvedEndpoints_.empty() &&
+        std::chrono::steady_clock::now() - resolvedAt_ < reconnectConfig_.dnsCacheTtl) {
+        doConnect(resolvedEndpoints_);
+        return;
+    }
+
+    resolver_.async_resolve(
+        host_,
+        std::to_string(port_),
+        [this, self](const boost::system::error_code& ec,
+                     asio::ip::tcp::resolver::results_type results) {
+            if (ec) {
+                if (ec != asio::error::operation_aborted && onError_) {
+                    onError_(ec);
+                }
+                handleDisconnect(ec);
+                return;
+            }
+
+            resolvedEndpoints_ = results;
+            resolvedAt_ = std::chrono::steady_clock::now();
+            doConnect(results);
+        }
+    );
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::doConnect(const asio::ip::tcp::resolver::results_type& endpoints) {
+    auto self = this->shared_from_this();
+
+    // A fresh connector per connect: handlers of a cancelled one keep their
+    // own object alive and never touch this client
+    auto connector = std::make_shared<Connector>(strand_, connectConfig_, socketConfig_);
+    connector_ = connector;
+    connector->start(endpoints, [this, self, connector](const boost::system::error_code& ec) {
+        connector_.reset();
+        if (!ec) {
+            transport_.assign(std::move(connector->socket()));
+#if defined(ASIOCLIENT_HAS_TLS)
+            if (tlsContext_) {
+                startHandshake();
+                return;
+            }
+#endif
+        }
+        handleConnect(ec);
+    });
+}
+
+#if defined(ASIOCLIENT_HAS_TLS)
+template <typename Framing>
+void BasicTcpClient<Framing>::startHandshake() {
+    // Resumes the endpoint's cached session when the context has one, so a
+    // reconnect storm costs abbreviated handshakes only
+    transport_.startTls(tlsContext_, host_, port_);
+
+    handshakeTimedOut_ = false;
+    if (connectConfig_.handshakeTimeout.count() > 0) {
+        std::weak_ptr<BasicTcpClient> weak = this->shared_from_this();
+        uint64_t connection = ++connectionId_;
+        handshakeTimer_ = timerWheel_->schedule(connectConfig_.handshakeTimeout, [weak, connection]() {
+            if (auto self = weak.lock()) {
+                asio::post(self->strand_, [self, connection]() {
+                    self->checkHandshake(connection);
+                });
+            }
+        });
+    }
+
+    auto self = this->shared_from_this();
+    transport_.asyncHandshake([this, self](const boost::system::error_code& ec) {
+        timerWheel_->cancel(handshakeTimer_);
+        handshakeTimer_ = 0;
+
+        // disconnect() closed the transport under the handshake
+        if (state_ != ClientState::Connecting) {
+            return;
+        }
+
+        if (!ec && statsConfig_.enabled) {
+            StatsCounters::add(stats_.tlsHandshakes);
+            if (transport_.sessionReused()) {
+                StatsCounters::add(stats_.tlsResumptions);
+            }
+        }
+        handleConnect(ec && handshakeTimedOut_ ? asio::error::timed_out : ec);
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::checkHandshake(uint64_t connection) {
+    if (connection != connectionId_ || state_ != ClientState::Connecting || !handshakeTimer_) {
+        return;
+    }
+    handshakeTimer_ = 0;
+    handshakeTimedOut_ = true;
+
+    boost::system::error_code ignored;
+    transport_.close(ignored);  // Fails the handshake, reported as timed_out
+}
+#endif
+
+template <typename Framing>
+void BasicTcpClient<Framing>::handleConnect(const boost::system::error_code& ec) {
+    // Set TCP_NODELAY to disable Nagle's algorithm; a socket that refuses it
+    // is already unusable, which makes this a failed connect
+    boost::system::error_code error = ec;
+    if (!error) {
+        transport_.socket().set_option(asio::ip::tcp::no_delay(true), error);
+    }
+
+    if (error) {
+        // The server may have moved: resolve again on the next attempt
+        resolvedEndpoints_ = asio::ip::tcp::resolver::results_type();
+        if (statsConfig_.enabled) {
+            StatsCounters::add(stats_.connectFailures);
+        }
+        if (onError_) {
+            onError_(error);
+        }
+        handleDisconnect(error);
+        return;
+    }
+
+    state_ = ClientState::Connected;
+    resetReconnectState();
+    ++connectionId_;
+
+    if (statsConfig_.enabled) {
+        StatsCounters::add(stats_.connects);
+        stats_.connectDuration.record(StatsCounters::elapsedNs(connectStartedAt_));
+    }
+
+    applyTcpKeepalive();
+    applySocketOptions();
+    zeroCopyNextId_ = 0;
+    zeroCopy_ = writeConfig_.zeroCopyThreshold > 0 && !transport_.isTls() &&
+                zerocopy::enable(transport_.socket().native_handle());
+
+    if (onConnected_) {
+        onConnected_();
+    }
+    completeConnectWaiters(boost::system::error_code());
+
+    // The callback may have disconnected the client
+    if (!isConnected()) {
+        return;
+    }
+
+    startReading();
+    writeIfReady();
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::handleDisconnect(const boost::system::error_code& ec) {
+    if (state_ == ClientState::Disconnected) {
+        return;
+    }
+
+    boost::system::error_code ignored;
+    transport_.close(ignored);
+    paceTimer_.cancel();
+    releaseZeroCopy();
+    cancelTimeouts();
+    failReceiveWaiters(ec);
+    replayQueued(ec);
+
+    if (state_ == ClientState::Connected && statsConfig_.enabled) {
+        StatsCounters::add(stats_.disconnects);
+    }
+
+    if (userDisconnect_) {
+        state_ = ClientState::Disconnected;
+        if (onDisconnected_) {
+            onDisconnected_();
+        }
+        return;
+    }
+
+    if (state_ == ClientState::Connected && onDisconnected_) {
+        onDisconnected_();
+    }
+
+    if (reconnectConfig_.enabled) {
+        doReconnect();
+    } else {
+        state_ = ClientState::Disconnected;
+    }
+
+    // Given up: asyncConnect() callers get the last error
+    if (state_ == ClientState::Disconnected) {
+        completeConnectWaiters(ec);
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::applyTcpKeepalive() {
+    if (!tcpKeepaliveConfig_.enabled) {
+        return;
+    }
+
+    // Best effort: a platform without the tuning options keeps its defaults
+    boost::system::error_code ignored;
+    transport_.socket().set_option(asio::socket_base::keep_alive(true), ignored);
+#if defined(TCP_KEEPIDLE)
+    transport_.socket().set_option(detail::IntSocketOption(IPPROTO_TCP, TCP_KEEPIDLE,
+        static_cast<int>(tcpKeepaliveConfig_.idle.count())), ignored);
+#elif defined(TCP_KEEPALIVE)
+    transport_.socket().set_option(detail::IntSocketOption(IPPROTO_TCP, TCP_KEEPALIVE,
+        static_cast<int>(tcpKeepaliveConfig_.idle.count())), ignored);
+#endif
+#if defined(TCP_KEEPINTVL)
+    transport_.socket().set_option(detail::IntSocketOption(IPPROTO_TCP, TCP_KEEPINTVL,
+        static_cast<int>(tcpKeepaliveConfig_.interval.count())), ignored);
+#endif
+#if defined(TCP_KEEPCNT)
+    transport_.socket().set_option(detail::IntSocketOption(IPPROTO_TCP, TCP_KEEPCNT, tcpKeepaliveConfig_.probes), ignored);
+#endif
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::applySocketOptions() {
+    // Best effort like the keepalive tuning; buffer sizes were set by the Connector
+#if defined(SO_BUSY_POLL)
+    if (socketConfig_.busyPoll.count() > 0) {
+        boost::system::error_code ignored;
+        transport_.socket().set_option(detail::IntSocketOption(SOL_SOCKET, SO_BUSY_POLL,
+            static_cast<int>(socketConfig_.busyPoll.count())), ignored);
+    }
+#endif
+#if defined(TCP_USER_TIMEOUT)
+    if (socketConfig_.userTimeout.count() > 0) {
+        boost::system::error_code ignored;
+        transport_.socket().set_option(detail::IntSocketOption(IPPROTO_TCP, TCP_USER_TIMEOUT,
+            static_cast<int>(socketConfig_.userTimeout.count())), ignored);
+    }
+#endif
+    rearmQuickAck();
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::rearmQuickAck() {
+#if defined(TCP_QUICKACK)
+    if (socketConfig_.quickAck) {
+        boost::system::error_code ignored;
+        transport_.socket().set_option(detail::IntSocketOption(IPPROTO_TCP, TCP_QUICKACK, 1), ignored);
+    }
+#endif
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::doReconnect() {
+    if (reconnectConfig_.maxRetries >= 0 &&
+        reconnectAttempts_ >= reconnectConfig_.maxRetries) {
+        state_ = ClientState::Disconnected;
+        return;
+    }
+
+    state_ = ClientState::Reconnecting;
+    auto delay = calculateReconnectDelay();
+    reconnectAttempts_++;
+
+    auto self = this->shared_from_this();
+    reconnectTimer_.expires_after(delay);
+    reconnectTimer_.async_wait([this, self](const boost::system::error_code& ec) {
+        if (ec) {
+            return;
+        }
+
+        if (userDisconnect_) {
+            return;
+        }
+
+        if (statsConfig_.enabled) {
+            StatsCounters::add(stats_.reconnects);
+        }
+
+        // Recreate socket for reconnection
+        transport_.assign(asio::ip::tcp::socket(strand_));
+        state_ = ClientState::Connecting;
+        startConnectAttempt();
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::startConnectAttempt() {
+    // Wait for a slot of the shared budget; the reservation keeps clients
+    // that queue up behind an empty bucket in arrival order
+    std::chrono::nanoseconds wait(0);
+    if (reconnectConfig_.connectLimiter) {
+        wait = reconnectConfig_.connectLimiter->reserve();
+    }
+    if (wait.count() <= 0) {
+        doResolve();
+        return;
+    }
+
+    auto self = this->shared_from_this();
+    reconnectTimer_.expires_after(wait);
+    reconnectTimer_.async_wait([this, self](const boost::system::error_code& ec) {
+        if (ec || userDisconnect_) {
+            return;
+        }
+        doResolve();
+    });
+}
+
+template <typename Framing>
+std::chrono::milliseconds BasicTcpClient<Framing>::calculateReconnectDelay() {
+    using std::chrono::milliseconds;
+
+    milliseconds delay = reconnectConfig_.initialDelay;
+    if (reconnectAttempts_ > 0) {
+        double multiplier = std::pow(reconnectConfig_.backoffMultiplier, reconnectAttempts_);
+        delay = std::chrono::duration_cast<milliseconds>(reconnectConfig_.initialDelay * multiplier);
+    }
+    delay = std::min(delay, reconnectConfig_.maxDelay);
+
+    auto uniform = [this](milliseconds low, milliseconds high) {
+        if (high <= low) {
+            return low;
+        }
+        std::uniform_int_distribution<milliseconds::rep> dist(low.count(), high.count());
+        return milliseconds(dist(jitterRng_));
+    };
+
+    switch (reconnectConfig_.jitter) {
+        case ReconnectJitter::Full:
+            delay = uniform(milliseconds(0), delay);
+            break;
+
+        case ReconnectJitter::Equal:
+            delay = delay / 2 + uniform(milliseconds(0), delay - delay / 2);
+            break;
+
+        case ReconnectJitter::Decorrelated: {
+            // Grows from the previous (random) delay rather than the attempt count
+            milliseconds base = reconnectConfig_.initialDelay;
+            milliseconds previous = std::max(lastReconnectDelay_, base);
+            delay = std::min(uniform(base, previous * 3), reconnectConfig_.maxDelay);
+            break;
+        }
+
+        case ReconnectJitter::None:
+        default:
+            break;
+    }
+
+    lastReconnectDelay_ = delay;
+    return delay;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::armReadIdle(std::chrono::nanoseconds delay) {
+    // The wheel must not keep the client alive: hold it weakly
+    std::weak_ptr<BasicTcpClient> weak = this->shared_from_this();
+    uint64_t connection = connectionId_;
+    readIdleTimer_ = timerWheel_->schedule(delay, [weak, connection]() {
+        if (auto self = weak.lock()) {
+            asio::post(self->strand_, [self, connection]() {
+                self->checkReadIdle(connection);
+            });
+        }
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::armWriteStall(std::chrono::nanoseconds delay) {
+    std::weak_ptr<BasicTcpClient> weak = this->shared_from_this();
+    uint64_t connection = connectionId_;
+    writeStallTimer_ = timerWheel_->schedule(delay, [weak, connection]() {
+        if (auto self = weak.lock()) {
+            asio::post(self->strand_, [self, connection]() {
+                self->checkWriteStall(connection);
+            });
+        }
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::checkReadIdle(uint64_t connection) {
+    if (connection != connectionId_ || !isConnected()) {
+        return;
+    }
+    readIdleTimer_ = 0;
+
+    // Reading paused on a full receive queue is our doing, not the peer's
+    if (readPaused_) {
+        lastReadAt_ = StatsCounters::Clock::now();
+    }
+
+    // Reads only stamp lastReadAt_; re-arm for whatever is left of the window
+    auto idle = StatsCounters::Clock::now() - lastReadAt_;
+    if (idle < timeoutConfig_.readIdle) {
+        armReadIdle(timeoutConfig_.readIdle - idle);
+        return;
+    }
+
+    boost::system::error_code ec = asio::error::timed_out;
+    if (onError_) {
+        onError_(ec);
+    }
+    handleDisconnect(ec);
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::checkWriteStall(uint64_t connection) {
+    if (connection != connectionId_ || !isConnected()) {
+        return;
+    }
+    writeStallTimer_ = 0;
+
+    // No write in flight: the next startWrite() arms a new check
+    if (writeBatchCount_ == 0 || paceWaiting_) {
+        return;
+    }
+
+    auto pending = StatsCounters::Clock::now() - writeStartedAt_;
+    if (pending < timeoutConfig_.writeStall) {
+        armWriteStall(timeoutConfig_.writeStall - pending);
+        return;
+    }
+
+    boost::system::error_code ec = asio::error::timed_out;
+    if (onError_) {
+        onError_(ec);
+    }
+    handleDisconnect(ec);
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::armHeartbeat(std::chrono::nanoseconds delay) {
+    std::weak_ptr<BasicTcpClient> weak = this->shared_from_this();
+    uint64_t connection = connectionId_;
+    heartbeatTimer_ = timerWheel_->schedule(delay, [weak, connection]() {
+        if (auto self = weak.lock()) {
+            asio::post(self->strand_, [self, connection]() {
+                self->checkHeartbeat(connection);
+            });
+        }
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::checkHeartbeat(uint64_t connection) {
+    if (connection != connectionId_ || !isConnected()) {
+        return;
+    }
+    heartbeatTimer_ = 0;
+
+    auto now = StatsCounters::Clock::now();
+    if (readPaused_) {
+        lastReadAt_ = now;
+    }
+
+    std::chrono::nanoseconds interval = heartbeatConfig_.interval;
+    std::chrono::nanoseconds deadAfter = interval * std::max(heartbeatConfig_.missedIntervals, 1);
+    std::chrono::nanoseconds silent = now - lastReadAt_;
+    if (silent >= deadAfter) {
+        boost::system::error_code ec = asio::error::timed_out;
+        if (onError_) {
+            onError_(ec);
+        }
+        handleDisconnect(ec);
+        return;
+    }
+
+    // A write in progress is traffic already; otherwise ping once the line went quiet
+    std::chrono::nanoseconds quiet = now - lastWriteAt_;
+    if (writeQueue_.empty() && quiet >= interval) {
+        sendHeartbeat();
+        quiet = std::chrono::nanoseconds(0);
+    }
+
+    std::chrono::nanoseconds nextPing = quiet < interval ? interval - quiet : interval;
+    armHeartbeat(std::min(nextPing, deadAfter - silent));
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::sendHeartbeat() {
+    // Same path as send(): counted, corked and paced like any other frame
+    OutboundFrame frame;
+    frame.heartbeat = true;
+    if (statsConfig_.enabled) {
+        StatsCounters::add(stats_.heartbeatsOut);
+    }
+    enqueue(std::move(frame));
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::cancelTimeouts() {
+    timerWheel_->cancel(readIdleTimer_);
+    timerWheel_->cancel(writeStallTimer_);
+    timerWheel_->cancel(heartbeatTimer_);
+    timerWheel_->cancel(handshakeTimer_);
+    readIdleTimer_ = 0;
+    writeStallTimer_ = 0;
+    heartbeatTimer_ = 0;
+    handshakeTimer_ = 0;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::resetReconnectState() {
+    reconnectAttempts_ = 0;
+    lastReconnectDelay_ = std::chrono::milliseconds(0);
+}
+
+template <typename Framing>
+ClientStats BasicTcpClient<Framing>::stats() const {
+    ClientStats stats = stats_.snapshot();
+    stats.queuedBytes = queuedBytes();
+    stats.queuedMessages = queuedMessages();
+    return stats;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::scheduleStatsReport() {
+    if (!onStats_ || statsConfig_.reportInterval.count() <= 0) {
+        return;
+    }
+
+    auto self = this->shared_from_this();
+    statsTimer_.expires_after(statsConfig_.reportInterval);
+    statsTimer_.async_wait([this, self](const boost::system::error_code& ec) {
+        if (ec || userDisconnect_) {
+            return;
+        }
+
+        onStats_(stats());
+        scheduleStatsReport();
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::startReading() {
+    trackReads_ = timeoutConfig_.readIdle.count() > 0 || heartbeatConfig_.interval.count() > 0;
+    lastReadAt_ = StatsCounters::Clock::now();
+    if (timeoutConfig_.readIdle.count() > 0) {
+        armReadIdle(timeoutConfig_.readIdle);
+    }
+    if (heartbeatConfig_.interval.count() > 0) {
+        lastWriteAt_ = lastReadAt_;
+        armHeartbeat(heartbeatConfig_.interval);
+    }
+
+    readPaused_ = false;
+    if (deliveryBlocked()) {
+        readPaused_ = true;
+        if (!ringPending_.empty()) {
+            armDispatchRetry();  // Cancelled by the disconnect that left them pending
+        }
+        if (readConfig_.readAhead) {
+            readStart_ = 0;
+            readEnd_ = 0;
+        }
+        return;
+    }
+
+    if (readConfig_.readAhead) {
+        readStart_ = 0;
+        readEnd_ = 0;
+        doReadSome();
+    } else {
+        doReadHeader();
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::doReadHeader(size_t received) {
+    auto self = this->shared_from_this();
+
+    // Fixed-size headers arrive in one read; variable-length ones a byte at a
+    // time once the minimum is in
+    size_t wanted = received < Framing::kMinHeaderSize ? Framing::kMinHeaderSize - received : 1;
+
+    asio::async_read(
+        transport_,
+        asio::buffer(headerBuffer_.data() + received, wanted),
+        [this, self, received, wanted](const boost::system::error_code& ec, std::size_t /*length*/) {
+            if (ec) {
+                if (ec != asio::error::operation_aborted) {
+                    if (onError_) {
+                        onError_(ec);
+                    }
+                    handleDisconnect(ec);
+                }
+                return;
+            }
+
+            if (statsConfig_.enabled) {
+                StatsCounters::add(stats_.bytesIn, wanted);
+            }
+            if (trackReads_) {
+                lastReadAt_ = StatsCounters::Clock::now();
+            }
+            rearmQuickAck();
+
+            FrameHeader header;
+            if (Framing::decode(headerBuffer_.data(), received + wanted, header) == 0) {
+                doReadHeader(received + wanted);
+                return;
+            }
+            size_t bodyLen = header.bodySize;
+            bool compressed = header.compressed;
+
+            // Validate message length
+            if (!isValidFrame(header)) {
+                boost::system::error_code invalidEc =
+                    boost::system::errc::make_error_code(boost::system::errc::message_size);
+                if (onError_) {
+                    onError_(invalidEc);
+                }
+                handleDisconnect(invalidEc);
+                return;
+            }
+
+            if (bodyLen > 0) {
+                doReadBody(bodyLen, compressed);
+            } else {
+                deliverFrame(std::vector<char>());
+                if (flushBatch()) {
+                    continueReadHeader();
+                }
+            }
+        }
+    );
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::doReadBody(size_t bodyLen, bool compressed) {
+    auto self = this->shared_from_this();
+    bodyBuffer_ = bufferPool_.acquire(bodyLen);
+
+    asio::async_read(
+        transport_,
+        asio::buffer(bodyBuffer_),
+        [this, self, compressed](const boost::system::error_code& ec, std::size_t /*length*/) {
+            if (ec) {
+                if (ec != asio::error::operation_aborted) {
+                    if (onError_) {
+                        onError_(ec);
+                    }
+                    handleDisconnect(ec);
+                }
+                return;
+            }
+
+            if (statsConfig_.enabled) {
+                StatsCounters::add(stats_.bytesIn, bodyBuffer_.size());
+            }
+            if (trackReads_) {
+                lastReadAt_ = StatsCounters::Clock::now();
+            }
+            rearmQuickAck();
+
+            if (compressed) {
+                bool ok = deliverCompressed(bodyBuffer_.data(), bodyBuffer_.size());
+                bufferPool_.release(std::move(bodyBuffer_));
+                if (!ok) {
+                    return;
+                }
+            } else {
+                deliverFrame(std::move(bodyBuffer_));
+            }
+            if (flushBatch()) {
+                continueReadHeader();
+            }
+        }
+    );
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::continueReadHeader() {
+    // Stop reading while asyncReceive() or the dispatch consumer is behind;
+    // whichever catches up resumes
+    if (deliveryBlocked()) {
+        readPaused_ = true;
+        return;
+    }
+    doReadHeader();
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::resumeReading() {
+    readPaused_ = false;
+    if (!isConnected()) {
+        return;
+    }
+
+    if (readConfig_.readAhead) {
+        if (parseFrames()) {
+            doReadSome();
+        }
+    } else {
+        doReadHeader();
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::doReadSome() {
+    auto self = this->shared_from_this();
+
+    // Reclaim the parsed prefix: drop it when everything was consumed,
+    // otherwise move the partial frame to the front of the buffer
+    if (readStart_ == readEnd_) {
+        readStart_ = 0;
+        readEnd_ = 0;
+        if (readBuffer_.size() > readConfig_.bufferSize) {
+            std::vector<char>(readConfig_.bufferSize).swap(readBuffer_);  // Release jumbo frame space
+        }
+    } else if (readStart_ > 0) {
+        std::memmove(readBuffer_.data(), readBuffer_.data() + readStart_, readEnd_ - readStart_);
+        readEnd_ -= readStart_;
+        readStart_ = 0;
+    }
+
+    // Make sure a partially received frame fits entirely
+    size_t required = std::max<size_t>(readConfig_.bufferSize, Framing::kMaxHeaderSize);
+    FrameHeader pending;
+    size_t headerSize = Framing::decode(readBuffer_.data(), readEnd_, pending);
+    if (headerSize > 0 && pending.bodySize <= Framing::kMaxBodySize) {
+        required = std::max<size_t>(required, headerSize + pending.bodySize);
+    }
+    if (readBuffer_.size() < required) {
+        readBuffer_.resize(required);
+    }
+
+    transport_.async_read_some(
+        asio::buffer(readBuffer_.data() + readEnd_, readBuffer_.size() - readEnd_),
+        [this, self](const boost::system::error_code& ec, std::size_t length) {
+            if (ec) {
+                if (ec != asio::error::operation_aborted) {
+                    if (onError_) {
+                        onError_(ec);
+                    }
+                    handleDisconnect(ec);
+                }
+                return;
+            }
+
+            readEnd_ += length;
+            if (statsConfig_.enabled) {
+                StatsCounters::add(stats_.bytesIn, length);
+            }
+            if (trackReads_) {
+                lastReadAt_ = StatsCounters::Clock::now();
+            }
+            rearmQuickAck();
+            if (parseFrames()) {
+                doReadSome();
+            }
+        }
+    );
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::parseFrames() {
+    while (readEnd_ - readStart_ >= Framing::kMinHeaderSize) {
+        if (deliveryBlocked()) {
+            readPaused_ = true;
+            flushBatch();
+            return false;
+        }
+
+        const char* frame = readBuffer_.data() + readStart_;
+        FrameHeader header;
+        size_t headerSize = Framing::decode(frame, readEnd_ - readStart_, header);
+        if (headerSize == 0) {
+            break;  // Header incomplete
+        }
+        size_t bodyLen = header.bodySize;
+        bool compressed = header.compressed;
+
+        // Validate message length; the frames before it are still delivered
+        if (!isValidFrame(header)) {
+            if (!flushBatch()) {
+                return false;
+            }
+            boost::system::error_code invalidEc =
+                boost::system::errc::make_error_code(boost::system::errc::message_size);
+            if (onError_) {
+                onError_(invalidEc);
+            }
+            handleDisconnect(invalidEc);
+            return false;
+        }
+
+        if (readEnd_ - readStart_ < headerSize + bodyLen) {
+            break;  // Incomplete frame, wait for more data
+        }
+
+        readStart_ += headerSize + bodyLen;
+        if (compressed) {
+            if (!deliverCompressed(frame + headerSize, bodyLen)) {
+                return false;
+            }
+        } else {
+            deliverFrame(frame + headerSize, bodyLen);
+        }
+
+        // The callback may have disconnected the client
+        if (!isConnected()) {
+            return false;
+        }
+    }
+
+    return flushBatch();
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::deliverFrame(const char* body, size_t len) {
+    if (statsConfig_.enabled) {
+        StatsCounters::add(stats_.messagesIn);
+    }
+
+    // Heartbeats only refresh lastReadAt_, which the read already did
+    if (len == 0 && heartbeatConfig_.interval.count() > 0) {
+        if (statsConfig_.enabled) {
+            StatsCounters::add(stats_.heartbeatsIn);
+        }
+        return;
+    }
+
+    if (dispatchConfig_.mode != DispatchMode::Inline) {
+        Message msg;
+        msg.setBody(body, len);
+        dispatchMessage(std::move(msg));
+        return;
+    }
+
+    // Collected here, handed over by flushBatch() once the receive is parsed
+    if (onMessageBatch_) {
+        batchViews_.emplace_back(body, len);
+        return;
+    }
+
+    if (onMessageView_) {
+        onMessageView_(MessageView(body, len));
+    }
+
+    // Only materialize an owning Message when someone asked for one
+    if (onMessage_) {
+        if (len <= INLINE_BODY_SIZE) {
+            Message msg(body, len);
+            onMessage_(msg);
+            return;
+        }
+
+        std::vector<char> data = bufferPool_.acquire(len);
+        std::memcpy(data.data(), body, len);
+        Message msg(std::move(data));
+        onMessage_(msg);
+
+        // Whatever the callback did not move out goes back to the pool
+        if (!msg.isInline()) {
+            bufferPool_.release(std::move(msg.body()));
+        }
+    } else if (!onMessageView_ && receiveQueueEnabled_) {
+        Message msg;
+        msg.setBody(body, len);
+        queueReceived(std::move(msg));
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::deliverFrame(std::vector<char>&& body) {
+    if (statsConfig_.enabled) {
+        StatsCounters::add(stats_.messagesIn);
+    }
+
+    if (body.empty() && heartbeatConfig_.interval.count() > 0) {
+        if (statsConfig_.enabled) {
+            StatsCounters::add(stats_.heartbeatsIn);
+        }
+        return;
+    }
+
+    // A large pooled body leaves with the message and is freed by the consumer
+    if (dispatchConfig_.mode != DispatchMode::Inline) {
+        dispatchMessage(adoptBody(std::move(body)));
+        return;
+    }
+
+    // The body is kept until flushBatch(); moving it does not move its bytes
+    if (onMessageBatch_) {
+        batchViews_.emplace_back(body.data(), body.size());
+        batchBodies_.push_back(std::move(body));
+        return;
+    }
+
+    if (onMessageView_) {
+        onMessageView_(MessageView(body.data(), body.size()));
+    }
+
+    Message msg = adoptBody(std::move(body));
+    if (onMessage_) {
+        onMessage_(msg);
+    } else if (!onMessageView_ && receiveQueueEnabled_) {
+        queueReceived(std::move(msg));
+        return;
+    }
+
+    // Whatever the callback did not move out goes back to the pool
+    if (!msg.isInline()) {
+        bufferPool_.release(std::move(msg.body()));
+    }
+}
+
+template <typename Framing>
+Message BasicTcpClient<Framing>::adoptBody(std::vector<char>&& body) {
+    // Small bodies fit in the message; their pooled buffer goes straight back
+    if (body.size() <= INLINE_BODY_SIZE) {
+        Message msg(body.data(), body.size());
+        bufferPool_.release(std::move(body));
+        return msg;
+    }
+    return Message(std::move(body));
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::isValidFrame(const FrameHeader& header) const {
+    if (!header.compressed) {
+        return header.bodySize <= Framing::kMaxBodySize;
+    }
+
+    // Without a codec the flag is just the top bit of the length, which makes
+    // the unmasked header an invalid length
+    if (codec_.config().codec == CompressionCodec::None) {
+        return Message::isValidLength(static_cast<uint32_t>(header.bodySize) | COMPRESSED_FLAG);
+    }
+    return header.bodySize > 0 && header.bodySize <= Framing::kMaxBodySize;
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::deliverCompressed(const char* data, size_t len) {
+    // Decompressed straight into a pooled body, then delivered like any other
+    uint32_t original = 0;
+    std::vector<char> body;
+    bool ok = FrameCodec::originalSize(data, len, original) && original <= Framing::kMaxBodySize;
+    if (ok) {
+        body = bufferPool_.acquire(original);
+        ok = codec_.decompress(data, len, body.data(), original);
+    }
+
+    if (!ok) {
+        bufferPool_.release(std::move(body));
+        if (!flushBatch()) {
+            return false;
+        }
+        boost::system::error_code invalidEc =
+            boost::system::errc::make_error_code(boost::system::errc::bad_message);
+        if (onError_) {
+            onError_(invalidEc);
+        }
+        handleDisconnect(invalidEc);
+        return false;
+    }
+
+    deliverFrame(std::move(body));
+    return true;
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::flushBatch() {
+    if (!dispatchBatch_.empty()) {
+        postDispatchBatch();
+    }
+    if (!batchViews_.empty()) {
+        onMessageBatch_(MessageBatch(batchViews_.data(), batchViews_.size()));
+        batchViews_.clear();
+        for (auto& body : batchBodies_) {
+            bufferPool_.release(std::move(body));
+        }
+        batchBodies_.clear();
+    }
+
+    // The callback may have disconnected the client
+    return isConnected();
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::dispatchMessage(Message&& message) {
+    if (dispatchConfig_.mode == DispatchMode::Executor) {
+        dispatchBatch_.push_back(std::move(message));
+        if (dispatchBatch_.size() >= std::max<size_t>(dispatchConfig_.maxBatch, 1)) {
+            postDispatchBatch();
+        }
+        return;
+    }
+
+    // Ring: keep the order, once one message waits every later one does too
+    if (!ringPending_.empty() || !dispatchConfig_.ring->tryPush(std::move(message))) {
+        ringPending_.push_back(std::move(message));
+        armDispatchRetry();
+    }
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::postDispatchBatch() {
+    auto self = this->shared_from_this();
+    size_t limit = std::max<size_t>(dispatchConfig_.maxPendingBatches, 1);
+
+    dispatchInFlight_.fetch_add(1, std::memory_order_acq_rel);
+    std::vector<Message> batch;
+    batch.swap(dispatchBatch_);
+
+    // With reading paused nothing else may keep ioContext_ running for the wake-up
+    auto work = asio::make_work_guard(strand_);
+    asio::post(dispatchConfig_.executor, [this, self, limit, work = std::move(work),
+                                          batch = std::move(batch)]() mutable {
+        if (onDispatch_) {
+            onDispatch_(batch);
+        }
+
+        // Reading may have paused on this batch
+        if (dispatchInFlight_.fetch_sub(1, std::memory_order_acq_rel) >= limit) {
+            asio::post(strand_, [this, self]() {
+                if (readPaused_ && !deliveryBlocked()) {
+                    resumeReading();
+                }
+            });
+        }
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::armDispatchRetry() {
+    if (dispatchRetryArmed_) {
+        return;
+    }
+    dispatchRetryArmed_ = true;
+
+    auto self = this->shared_from_this();
+    dispatchTimer_.expires_after(dispatchConfig_.ringRetry);
+    dispatchTimer_.async_wait([this, self](const boost::system::error_code& ec) {
+        dispatchRetryArmed_ = false;
+        if (ec) {
+            // A reconnect may have found the retry still armed
+            if (!ringPending_.empty() && isConnected()) {
+                armDispatchRetry();
+            }
+            return;
+        }
+
+        while (!ringPending_.empty() && dispatchConfig_.ring->tryPush(std::move(ringPending_.front()))) {
+            ringPending_.pop_front();
+        }
+        if (!ringPending_.empty()) {
+            armDispatchRetry();
+        } else if (readPaused_ && !deliveryBlocked()) {
+            resumeReading();
+        }
+    });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::doWrite() {
+    if (writeQueue_.empty()) {
+        return;
+    }
+
+    // Queued messages stay in writeQueue_ until the write completes; deque
+    // push_back never moves existing elements, so the buffers remain valid.
+    writeBuffers_.clear();
+    corkBuffer_.clear();
+    writeBatchCount_ = 0;
+    writeBatchBytes_ = 0;
+    // TLS writes one record per buffer, so small frames are flattened there
+    // too; large ones keep the gather pair and get a write of their own
+    bool flatten = writeConfig_.cork || transport_.isTls();
+    // Paced: take what the buckets hold now, but always at least one frame
+    double paceBytes = std::numeric_limits<double>::infinity();
+    double paceMessages = std::numeric_limits<double>::infinity();
+    if (pacing_) {
+        pacingBudget(paceBytes, paceMessages);
+    }
+    for (const auto& frame : writeQueue_) {
+        // File and zero-copy frames take a write of their own
+        bool solo = frame.file || wantsZeroCopy(frame);
+        if (solo && writeBatchCount_ > 0) {
+            break;
+        }
+        bool coalesce = !solo && flatten && frame.size() < writeConfig_.corkBytes;
+        if (writeBatchCount_ > 0) {
+            if (writeConfig_.cork
+                    ? !coalesce || writeBatchBytes_ + frame.size() > writeConfig_.maxBatchBytes
+                    : !writeConfig_.batching || (flatten && !coalesce) ||
+                      writeBuffers_.size() + 2 > writeConfig_.maxBatchBuffers ||
+                      writeBatchBytes_ + frame.size() > writeConfig_.maxBatchBytes) {
+                break;
+            }
+            if (static_cast<double>(writeBatchBytes_ + frame.size()) > paceBytes ||
+                static_cast<double>(writeBatchCount_ + 1) > paceMessages) {
+                break;
+            }
+        }
+        std::string_view body = frame.body();
+        if (coalesce) {
+            corkBuffer_.insert(corkBuffer_.end(), frame.header(), frame.header() + frame.headerSize);
+            corkBuffer_.insert(corkBuffer_.end(), body.begin(), body.end());
+        } else if (frame.inlineBody()) {
+            writeBuffers_.push_back(asio::buffer(frame.header(), frame.headerSize + body.size()));
+        } else {
+            writeBuffers_.push_back(asio::buffer(frame.header(), frame.headerSize));
+            if (!body.empty()) {
+                writeBuffers_.push_back(asio::buffer(body.data(), body.size()));
+            }
+        }
+        writeBatchBytes_ += frame.size();
+        ++writeBatchCount_;
+        if (solo || (flatten && !coalesce)) {
+            break;
+        }
+    }
+    if (!corkBuffer_.empty()) {
+        writeBuffers_.push_back(asio::buffer(corkBuffer_));
+    }
+
+    // Everything held back is on its way
+    if (writeBatchCount_ == writeQueue_.size()) {
+        flushRequested_ = false;
+        cancelCork();
+    }
+
+    // Out of tokens: the batch stays built and goes out from paceTimer_
+    if (pacing_) {
+        std::chrono::nanoseconds delay = reservePacing(writeBatchBytes_, writeBatchCount_);
+        if (delay.count() > 0) {
+            armPacing(delay);
+            return;
+        }
+    }
+    startWrite();
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::startWrite() {
+    auto self = this->shared_from_this();
+
+    if (heartbeatConfig_.interval.count() > 0) {
+        lastWriteAt_ = StatsCounters::Clock::now();
+    }
+    if (timeoutConfig_.writeStall.count() > 0) {
+        writeStartedAt_ = StatsCounters::Clock::now();
+        if (!writeStallTimer_) {
+            armWriteStall(timeoutConfig_.writeStall);
+        }
+    }
+
+    // The header goes out with the normal write, then the body from the file
+    const OutboundFrame& first = writeQueue_.front();
+    if (first.file) {
+        uint64_t connection = connectionId_;
+        asio::async_write(
+            transport_,
+            writeBuffers_,
+            [this, self, connection](const boost::system::error_code& ec, std::size_t /*length*/) {
+                if (connection != connectionId_) {
+                    return;
+                }
+                if (ec) {
+                    handleWrite(ec);
+                    return;
+                }
+                writeFileBody(0);
+            }
+        );
+        return;
+    }
+    if (writeBatchCount_ == 1 && wantsZeroCopy(first)) {
+        writeZeroCopy(0);
+        return;
+    }
+
+    asio::async_write(
+        transport_,
+        writeBuffers_,
+        [this, self](const boost::system::error_code& ec, std::size_t /*length*/) {
+            handleWrite(ec);
+        }
+    );
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::handleWrite(const boost::system::error_code& ec) {
+    if (ec) {
+        if (ec != asio::error::operation_aborted) {
+            if (onError_) {
+                onError_(ec);
+            }
+            handleDisconnect(ec);
+        }
+        return;
+    }
+
+    if (statsConfig_.enabled) {
+        auto now = StatsCounters::Clock::now();
+        for (size_t i = 0; i < writeBatchCount_; ++i) {
+            stats_.sendLatency.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    now - writeQueue_[i].enqueuedAt).count()));
+        }
+        StatsCounters::add(stats_.bytesOut, writeBatchBytes_);
+        StatsCounters::add(stats_.messagesOut, writeBatchCount_);
+        stats_.writeBatchMessages.record(writeBatchCount_);
+        stats_.writeBatchBytes.record(writeBatchBytes_);
+    }
+
+    // At-least-once: written frames stay queued (and counted) until acknowledged
+    bool retain = replayConfig_.policy == ReplayPolicy::AtLeastOnce;
+    size_t frames = writeBatchCount_;
+    size_t bytes = writeBatchBytes_;
+    for (size_t i = 0; i < writeBatchCount_; ++i) {
+        OutboundFrame& frame = writeQueue_[i];
+        if (retain && !frame.heartbeat && !frame.noReplay) {
+            --frames;
+            bytes -= frame.size();
+            unacked_.push_back(std::move(frame));
+            continue;
+        }
+        releaseFrame(frame, boost::system::error_code());
+    }
+
+    writeQueue_.erase(writeQueue_.begin(),
+                      writeQueue_.begin() + writeBatchCount_ + writeDropped_);
+    writeQueueBytes_ -= writeBatchBytes_;
+    writeBatchCount_ = 0;
+    writeBatchBytes_ = 0;
+    writeDropped_ = 0;
+    onDequeued(frames, bytes);
+
+    writeIfReady();
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::completeWrite(const boost::system::error_code& ec) {
+    // Writes done by hand may finish inline; complete them the way
+    // async_write would, from the strand and never from inside doWrite()
+    auto self = this->shared_from_this();
+    uint64_t connection = connectionId_;
+    asio::post(strand_, [this, self, connection, ec]() {
+        if (connection == connectionId_ && isConnected()) {
+            handleWrite(ec);
+        }
+    });
+}
+
+template <typename Framing>
+bool BasicTcpClient<Framing>::wantsZeroCopy(const OutboundFrame& frame) const {
+    return zeroCopy_ && !frame.file && !frame.inlineBody() &&
+           frame.body().size() >= writeConfig_.zeroCopyThreshold;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::writeZeroCopy(size_t offset) {
+    auto self = this->shared_from_this();
+    OutboundFrame& frame = writeQueue_.front();
+
+    // The kernel reads the body after the write completes: share it so the
+    // pin outlives the frame (the bytes do not move)
+    if (!frame.shared) {
+        frame.shared = std::make_shared<const std::vector<char>>(std::move(frame.owned));
+        frame.pooled = false;
+    }
+    if (writeBuffers_.front().data() == frame.header()) {
+        auto header = std::make_shared<const std::vector<char>>(
+            frame.header(), frame.header() + frame.headerSize);
+        writeBuffers_.front() = asio::buffer(*header);
+        zeroCopyHeader_ = std::move(header);
+    }
+
+    auto& socket = transport_.socket();
+    while (offset < writeBatchBytes_) {
+        boost::system::error_code ec;
+        size_t sent = zerocopy::send(socket.native_handle(), writeBuffers_.data(),
+                                     writeBuffers_.size(), offset, ec);
+        if (ec == asio::error::would_block) {
+            uint64_t connection = connectionId_;
+            socket.async_wait(asio::socket_base::wait_write,
+                [this, self, connection, offset](const boost::system::error_code& ec) {
+                    if (connection != connectionId_) {
+                        return;
+                    }
+                    if (ec) {
+                        handleWrite(ec);
+                        return;
+                    }
+                    writeZeroCopy(offset);
+                });
+            return;
+        }
+
+        if (ec == asio::error::no_buffer_space) {
+            // Out of memory to pin pages: the rest goes out the usual way
+            std::vector<asio::const_buffer> rest;
+            for (const auto& buffer : writeBuffers_) {
+                if (offset >= buffer.size()) {
+                    offset -= buffer.size();
+                    continue;
+                }
+                rest.push_back(buffer + offset);
+                offset = 0;
+            }
+            writeBuffers_.swap(rest);
+            armZeroCopyCompletions();
+            asio::async_write(transport_, writeBuffers_,
+                [this, self](const boost::system::error_code& ec, std::size_t /*length*/) {
+                    handleWrite(ec);
+                });
+            return;
+        }
+
+        if (ec) {
+            completeWrite(ec);
+            return;
+        }
+
+        // Every call that sent something takes one completion ID
+        zeroCopyPinned_.push_back(ZeroCopyPin{zeroCopyNextId_++, zeroCopyHeader_, frame.shared});
+        offset += sent;
+    }
+
+    zeroCopyHeader_.reset();
+    if (statsConfig_.enabled) {
+        StatsCounters::add(stats_.zeroCopySends);
+    }
+    armZeroCopyCompletions();
+    completeWrite(boost::system::error_code());
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::armZeroCopyCompletions() {
+    if (zeroCopyWaiting_ || zeroCopyPinned_.empty()) {
+        return;
+    }
+    zeroCopyWaiting_ = true;
+
+    auto self = this->shared_from_this();
+    uint64_t connection = connectionId_;
+    transport_.socket().async_wait(asio::socket_base::wait_error,
+        [this, self, connection](const boost::system::error_code& ec) {
+            // The disconnect already dropped this connection's pins
+            if (connection != connectionId_) {
+                return;
+            }
+            zeroCopyWaiting_ = false;
+            if (ec) {
+                return;
+            }
+
+            uint32_t last = 0;
+            bool copied = false;
+            while (zerocopy::nextCompletion(transport_.socket().native_handle(), last, copied)) {
+                while (!zeroCopyPinned_.empty() &&
+                       static_cast<int32_t>(zeroCopyPinned_.front().id - last) <= 0) {
+                    zeroCopyPinned_.pop_front();
+                }
+                if (copied && statsConfig_.enabled) {
+                    StatsCounters::add(stats_.zeroCopyCopied);
+                }
+            }
+            armZeroCopyCompletions();
+        });
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::releaseZeroCopy() {
+    // Once the socket is closed the kernel holds its own page references
+    zeroCopyPinned_.clear();
+    zeroCopyHeader_.reset();
+    zeroCopyWaiting_ = false;
+    zeroCopy_ = false;
+}
+
+template <typename Framing>
+void BasicTcpClient<Framing>::writeFileBody(uint64_t position) {
+    auto self = this->shared_from_this();
+    const FileBody& file = *writeQueue_.front().file;
+    uint64_t connection = connectionId_;
+
+    if (!transport_.isTls() && FileBody::canSendFile()) {
+        auto& socket = transport_.socket();
+        while (position < file.length()) {
+            boost::system::error_code ec;
+            size_t chunk = static_cast<size_t>(std::min<uint64_t>(file.length() - position, 1u << 30));
+            size_t sent = file.sendTo(socket.native_handle(), position, chunk, ec);
+            if (ec == asio::error::would_block) {
+                socket.async_wait(asio::socket_base::wait_write,
+                    [this, self, connection, position](const boost::system::error_code& ec) {
+                        if (connection != connectionId_) {
+                            return;
+                        }
+                        if (ec) {
+                            handleWrite(ec);
+                            return;
+                        }
+                        writeFileBody(position);
+                    });
+                return;
+            }
+            if (ec) {
+                // The header promised more bytes: the stream cannot continue
+                handleWrite(ec);
+                return;
+            }
+            position += sent;
+        }
+    } else if (position < file.length()) {
+        // Bounce buffer: TLS has to encrypt the bytes in user space anyway
+        constexpr size_t kFileChunk = 256 * 1024;
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(file.length() - position, kFileChunk));
+        fileChunk_.resize(chunk);
+        boost::system::error_code ec;
+        size_t read = file.read(position, fileChunk_.data(), chunk, ec);
+        if (ec) {
+            handleWrite(ec);
+            return;
+        }
+        asio::async_write(transport_, asio::buffer(fileChunk_.data(), read),
+            [this, self, connection, position, read](const boost::system::error_code& ec, std::size_t) {
+                if (connection != connectionId_) {
+                    return;
+                }
+                if (ec) {
+                    handleWrite(ec);
+                    return;
+                }
+                writeFileBody(position + read);
+            });
+        return;
+    }
+
+    if (statsConfig_.enabled) {
+        StatsCounters::add(stats_.filesSent);
+    }
+    if (fileChunk_.capacity() > 0) {
+        std::vector<char>().swap(fileChunk_);
+    }
+    handleWrite(boost::system::error_code());
+}
+
+} // namespace asioclient
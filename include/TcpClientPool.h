@@ -0,0 +1,172 @@
+/**
+ * @file TcpClientPool.h
+ * @brief Sharded multi-connection client over one io_context per core
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "TcpClient.h"
+
+namespace asioclient {
+
+/**
+ * @enum PoolPlacement
+ * @brief How connections are assigned to io_context shards
+ */
+enum class PoolPlacement {
+    RoundRobin,     // Connection i runs on shard i % threads
+    EndpointHash    // Connections to the same endpoint start on the same shard
+};
+
+/**
+ * @enum PoolRouting
+ * @brief How send(key, ...) picks a connection
+ */
+enum class PoolRouting {
+    ConsistentHash,    // Same key -> same connection while it is connected
+    LeastQueuedBytes,  // Connection with the smallest write backlog
+    RoundRobin         // Rotate over connections, key ignored
+};
+
+/**
+ * @struct PoolConfig
+ * @brief TcpClientPool configuration
+ */
+struct PoolConfig {
+    size_t threads = 0;                // io_context/thread count (0 = hardware concurrency)
+    size_t connectionsPerEndpoint = 1; // Connections opened per connect() endpoint
+    bool pinThreads = false;           // Pin IO thread i to CPU i % cores
+    PoolPlacement placement = PoolPlacement::RoundRobin;
+    PoolRouting routing = PoolRouting::ConsistentHash;
+    size_t virtualNodes = 64;          // Hash ring points per connection
+
+    // Applied to every connection
+    ReconnectConfig reconnect;
+    ConnectConfig connect;
+    WriteConfig write;
+    PacingConfig pacing;               // Rates are per connection; shared buckets cap the pool
+    ReadConfig read;
+    TimeoutConfig timeout;
+    HeartbeatConfig heartbeat;
+    TcpKeepaliveConfig tcpKeepalive;
+    SocketConfig socket;
+    ReplayConfig replay;               // A spill path gets the connection index appended
+    BufferPoolConfig bufferPool;
+    CompressionConfig compression;
+    StatsConfig stats;
+#if defined(ASIOCLIENT_HAS_TLS)
+    TlsContextPtr tls;                 // One SSL context and session cache for all connections
+#endif
+
+    // Per-connection setup run after the settings above, e.g. a DispatchConfig
+    // with the connection's own ring; message, connection and error callbacks
+    // set here are replaced by the pool's
+    std::function<void(size_t index, TcpClient& client)> configureClient;
+};
+
+/**
+ * @class TcpClientPool
+ * @brief Owns N io_contexts, each run by one thread, and spreads TcpClient
+ *        connections over them
+ *
+ * Each connection lives on exactly one io_context for its whole life, so its
+ * handlers never migrate between threads. Pool callbacks receive the
+ * connection index and may run concurrently on different IO threads.
+ * Callback setters and connect() must be called before traffic starts, from
+ * one thread; send() is thread-safe.
+ */
+class TcpClientPool {
+public:
+    // Callback type definitions (index = connection index)
+    using ConnectedCallback = std::function<void(size_t index)>;
+    using DisconnectedCallback = std::function<void(size_t index)>;
+    using MessageCallback = std::function<void(size_t index, Message&)>;
+    using ErrorCallback = std::function<void(size_t index, const boost::system::error_code&)>;
+
+    explicit TcpClientPool(const PoolConfig& config = PoolConfig());
+    ~TcpClientPool();
+
+    // Non-copyable
+    TcpClientPool(const TcpClientPool&) = delete;
+    TcpClientPool& operator=(const TcpClientPool&) = delete;
+
+    // Connection management
+    void connect(const std::string& host, uint16_t port);
+    void connect(const std::vector<std::pair<std::string, uint16_t>>& endpoints);
+    void disconnect();
+
+    /**
+     * @brief Send to the connection selected by the routing policy
+     * @param key Routing key (ignored by RoundRobin)
+     * @param payload Anything TcpClient::send() accepts
+     * @return false if rejected by the connection's backpressure policy
+     */
+    template <typename Payload>
+    bool send(uint64_t key, Payload&& payload) {
+        return clients_[route(key)]->send(std::forward<Payload>(payload));
+    }
+
+    template <typename Payload>
+    bool send(std::string_view key, Payload&& payload) {
+        return send(hashKey(key), std::forward<Payload>(payload));
+    }
+
+    /**
+     * @brief Pick the connection index for a routing key
+     */
+    size_t route(uint64_t key);
+
+    // Aggregated state
+    size_t size() const { return clients_.size(); }
+    size_t connectedCount() const;
+    bool allConnected() const { return !clients_.empty() && connectedCount() == clients_.size(); }
+    size_t queuedBytes() const;
+
+    // Per-connection / per-shard access
+    const TcpClientPtr& client(size_t index) const { return clients_.at(index); }
+    size_t threadCount() const { return contexts_.size(); }
+    asio::io_context& context(size_t shard) { return *contexts_.at(shard); }
+
+    // Callback setters (before connect)
+    void setOnConnected(ConnectedCallback cb) { onConnected_ = std::move(cb); }
+    void setOnDisconnected(DisconnectedCallback cb) { onDisconnected_ = std::move(cb); }
+    void setOnMessage(MessageCallback cb) { onMessage_ = std::move(cb); }
+    void setOnError(ErrorCallback cb) { onError_ = std::move(cb); }
+
+    static uint64_t hashKey(std::string_view key);
+
+private:
+    TcpClientPtr addClient(size_t shard);
+    void rebuildRing();
+    void pinThread(std::thread& thread, size_t cpu);
+
+    PoolConfig config_;
+
+    // One io_context per thread; clients_ is declared after contexts_ so the
+    // clients are destroyed first
+    std::vector<std::unique_ptr<asio::io_context>> contexts_;
+    std::vector<asio::executor_work_guard<asio::io_context::executor_type>> workGuards_;
+    std::vector<std::thread> threads_;
+    std::vector<TcpClientPtr> clients_;
+
+    // Routing state
+    std::vector<std::pair<uint64_t, size_t>> ring_;  // Sorted (point hash, connection index)
+    std::atomic<size_t> roundRobin_{0};
+    size_t nextShard_{0};
+
+    // Callbacks
+    ConnectedCallback onConnected_;
+    DisconnectedCallback onDisconnected_;
+    MessageCallback onMessage_;
+    ErrorCallback onError_;
+};
+
+} // namespace asioclient
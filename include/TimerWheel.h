@@ -0,0 +1,120 @@
+/**
+ * @file TimerWheel.h
+ * @brief Hierarchical timer wheel shared by all clients of an io_context
+ */
+#pragma once
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace asio = boost::asio;
+
+namespace asioclient {
+
+/**
+ * @class TimerWheel
+ * @brief Coarse timers for idle, heartbeat and request deadlines
+ *
+ * Four levels of 64 slots each, the first covering 64 ticks and every next
+ * level 64 times the previous one (about 46 hours at the default 10ms tick;
+ * longer delays are re-cascaded). Timers are nodes of intrusive lists in a
+ * slab, so schedule() and cancel() are O(1); expiry cascades entries one
+ * level down when a level wraps. The whole wheel is driven by a single
+ * steady_timer armed for the next occupied slot or cascade, so ticks with
+ * nothing due cost no wakeup.
+ *
+ * Thread-safe. Callbacks run on the wheel's own strand, never under its lock,
+ * and must post to their owner's strand themselves.
+ */
+class TimerWheel : public std::enable_shared_from_this<TimerWheel> {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+    using TimerId = uint64_t;  // 0 = no timer
+
+    static constexpr unsigned kSlotBits = 6;
+    static constexpr size_t kSlots = size_t(1) << kSlotBits;
+    static constexpr size_t kLevels = 4;
+    static constexpr std::chrono::milliseconds kDefaultTick{10};
+
+    TimerWheel(asio::io_context& ioContext, std::chrono::milliseconds tick = kDefaultTick);
+
+    // Non-copyable
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief The wheel shared by everything running on ioContext
+     * @param tick Resolution, only used by the call that creates the wheel
+     */
+    static std::shared_ptr<TimerWheel> forContext(asio::io_context& ioContext,
+                                                  std::chrono::milliseconds tick = kDefaultTick);
+
+    /**
+     * @brief Run callback once delay has elapsed (rounded up to the tick)
+     * @return Handle for cancel(); 0 once the io_context is shutting down
+     */
+    TimerId schedule(std::chrono::nanoseconds delay, Callback callback);
+
+    /**
+     * @return true if the timer was pending and will not run; stale ids are ignored
+     */
+    bool cancel(TimerId id);
+
+    size_t pending() const;
+    std::chrono::milliseconds tick() const { return tick_; }
+
+    /**
+     * @brief Drop every timer and stop ticking (io_context shutdown)
+     */
+    void shutdown();
+
+private:
+    static constexpr uint32_t kNil = UINT32_MAX;
+
+    struct Node {
+        uint64_t deadline = 0;     // Absolute tick
+        Callback callback;
+        uint32_t prev = kNil;
+        uint32_t next = kNil;
+        uint32_t generation = 0;   // Bumped on release so stale ids miss
+        uint16_t list = 0;         // level * kSlots + slot
+        bool linked = false;
+    };
+
+    uint64_t tickAt(Clock::time_point when) const;
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+    uint32_t allocate();
+    void release(uint32_t index);
+    void cascade(size_t level, uint64_t tick);
+    uint64_t nextEvent() const;
+    void advance(uint64_t target, std::vector<Callback>& expired);
+
+    void arm();     // strand only
+    void onTick();  // strand only
+
+    asio::strand<asio::io_context::executor_type> strand_;
+    std::unique_ptr<asio::steady_timer> timer_;    // Destroyed at io_context shutdown
+    const std::chrono::milliseconds tick_;
+    const Clock::time_point epoch_;
+
+    mutable std::mutex mutex_;
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> freeList_;
+    std::vector<uint32_t> heads_;                 // kLevels * kSlots list heads
+    uint64_t currentTick_{0};                     // Last tick processed
+    uint64_t armedTick_{0};                       // Tick timer_ waits for while armed_
+    size_t count_{0};
+    bool armed_{false};
+    bool stopped_{false};
+};
+
+using TimerWheelPtr = std::shared_ptr<TimerWheel>;
+
+} // namespace asioclient
@@ -0,0 +1,73 @@
+/**
+ * @file TokenBucket.h
+ * @brief Thread-safe token bucket for rate limiting shared by many clients
+ */
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace asioclient {
+
+/**
+ * @class TokenBucket
+ * @brief Refills `rate` tokens per second up to `burst`
+ *
+ * reserve() always succeeds: it takes the tokens now, letting the balance go
+ * negative, and returns how long the caller has to wait before it may act.
+ * Concurrent callers are therefore spaced 1/rate apart in arrival order
+ * instead of all retrying at the moment a token appears.
+ *
+ * Thread-safe; one bucket may be shared by clients on any io_context.
+ */
+class TokenBucket {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param rate Tokens per second (<= 0 = unlimited)
+     * @param burst Bucket capacity, also the initial balance (at least 1)
+     */
+    TokenBucket(double rate, double burst);
+
+    // Non-copyable
+    TokenBucket(const TokenBucket&) = delete;
+    TokenBucket& operator=(const TokenBucket&) = delete;
+
+    /**
+     * @brief Take tokens, borrowing from the future if the bucket is empty
+     * @return Delay before the reservation may be used (0 = now)
+     */
+    std::chrono::nanoseconds reserve(double tokens = 1.0);
+
+    // Take tokens only if they are available now
+    bool tryAcquire(double tokens = 1.0);
+
+    // Change the limit; the current balance is clamped to the new burst
+    void setRate(double rate, double burst);
+
+    double rate() const;
+    double burst() const;
+    double available() const;  // Current balance, negative while reservations are pending
+
+private:
+    void refill(Clock::time_point now);
+
+    mutable std::mutex mutex_;
+    double rate_;
+    double burst_;
+    double tokens_;
+    Clock::time_point last_;
+};
+
+using TokenBucketPtr = std::shared_ptr<TokenBucket>;
+
+/**
+ * @brief Factory function to create a TokenBucket to share between clients
+ */
+inline TokenBucketPtr createTokenBucket(double rate, double burst) {
+    return std::make_shared<TokenBucket>(rate, burst);
+}
+
+} // namespace asioclient
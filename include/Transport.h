@@ -0,0 +1,175 @@
+/**
+ * @file Transport.h
+ * @brief Client byte stream: plain TCP or TLS over TCP
+ */
+#pragma once
+
+#include <boost/asio.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+
+#if defined(ASIOCLIENT_HAS_TLS)
+    #include <boost/asio/ssl.hpp>
+    #include <atomic>
+    #include <mutex>
+    #include <unordered_map>
+#endif
+
+namespace asio = boost::asio;
+
+namespace asioclient {
+
+#if defined(ASIOCLIENT_HAS_TLS)
+
+/**
+ * @class TlsContext
+ * @brief ssl::context shared by any number of clients, plus their session cache
+ *
+ * Configure verification and certificates through context() before the first
+ * connect. With session resumption on, the sessions (tickets) servers issue
+ * are cached per host:port, and the next connection to that endpoint, from
+ * whichever client, offers the cached session instead of a full handshake.
+ *
+ * Thread-safe once configured.
+ */
+class TlsContext {
+public:
+    explicit TlsContext(asio::ssl::context::method method = asio::ssl::context::tls_client);
+
+    // Non-copyable
+    TlsContext(const TlsContext&) = delete;
+    TlsContext& operator=(const TlsContext&) = delete;
+
+    asio::ssl::context& context() { return context_; }
+
+    // Session resumption across connections (default on)
+    void setSessionResumption(bool enabled) { resumption_ = enabled; }
+    bool sessionResumption() const { return resumption_; }
+
+    size_t cachedSessions() const;
+    void clearSessions();
+
+private:
+    friend class Transport;
+    using SessionPtr = std::shared_ptr<SSL_SESSION>;
+
+    SessionPtr findSession(const std::string& key) const;
+    void storeSession(const std::string& key, SSL_SESSION* session);
+    static int onNewSession(SSL* ssl, SSL_SESSION* session);
+
+    asio::ssl::context context_;
+    std::atomic<bool> resumption_{true};
+    mutable std::mutex mutex_;                              // Guards sessions_
+    std::unordered_map<std::string, SessionPtr> sessions_;  // host:port -> latest session
+};
+
+using TlsContextPtr = std::shared_ptr<TlsContext>;
+
+/**
+ * @brief Factory function to create a TlsContext for clients
+ * @return Shared pointer to TlsContext, default peer verification off
+ */
+inline TlsContextPtr createTlsContext() {
+    return std::make_shared<TlsContext>();
+}
+
+#endif // ASIOCLIENT_HAS_TLS
+
+/**
+ * @class Transport
+ * @brief The connection of one TcpClient, plain or TLS
+ *
+ * Models AsyncReadStream / AsyncWriteStream, so asio::async_read and
+ * asio::async_write run over either layer. Like ssl::stream itself it allows
+ * one outstanding read and one outstanding write, all on the client's strand.
+ */
+class Transport {
+public:
+    using executor_type = asio::strand<asio::io_context::executor_type>;
+    using Socket = asio::ip::tcp::socket;
+
+    explicit Transport(const executor_type& executor);
+
+    executor_type get_executor() noexcept { return executor_; }
+
+    // The TCP socket underneath (socket options)
+    Socket& socket();
+
+    // Take over a new connection, back to plain TCP until startTls()
+    void assign(Socket&& socket);
+
+    bool isTls() const;
+
+#if defined(ASIOCLIENT_HAS_TLS)
+    /**
+     * @brief Layer TLS over the current socket, resuming a cached session if any
+     * @param host Server name for SNI, host name verification and the session cache
+     */
+    void startTls(const TlsContextPtr& context, const std::string& host, uint16_t port);
+
+    // Signature void(error_code)
+    template <typename Handler>
+    void asyncHandshake(Handler&& handler) {
+        tls_->async_handshake(asio::ssl::stream_base::client,
+            [stream = tls_, handler = std::forward<Handler>(handler)](
+                const boost::system::error_code& ec) mutable {
+                handler(ec);
+            });
+    }
+
+    // After the handshake: whether the cached session was accepted
+    bool sessionReused() const;
+#endif
+
+    void close(boost::system::error_code& ec);
+
+    template <typename MutableBufferSequence, typename Handler>
+    void async_read_some(const MutableBufferSequence& buffers, Handler&& handler) {
+#if defined(ASIOCLIENT_HAS_TLS)
+        if (tls_) {
+            // Outstanding TLS operations keep their stream alive across assign()
+            tls_->async_read_some(buffers,
+                [stream = tls_, handler = std::forward<Handler>(handler)](
+                    const boost::system::error_code& ec, std::size_t length) mutable {
+                    handler(ec, length);
+                });
+            return;
+        }
+#endif
+        socket_.async_read_some(buffers, std::forward<Handler>(handler));
+    }
+
+    template <typename ConstBufferSequence, typename Handler>
+    void async_write_some(const ConstBufferSequence& buffers, Handler&& handler) {
+#if defined(ASIOCLIENT_HAS_TLS)
+        if (tls_) {
+            tls_->async_write_some(buffers,
+                [stream = tls_, handler = std::forward<Handler>(handler)](
+                    const boost::system::error_code& ec, std::size_t length) mutable {
+                    handler(ec, length);
+                });
+            return;
+        }
+#endif
+        socket_.async_write_some(buffers, std::forward<Handler>(handler));
+    }
+
+private:
+#if defined(ASIOCLIENT_HAS_TLS)
+    friend class TlsContext;
+#endif
+
+    executor_type executor_;
+    Socket socket_;                       // Plain TCP; moved into tls_ by startTls()
+
+#if defined(ASIOCLIENT_HAS_TLS)
+    using TlsStream = asio::ssl::stream<Socket>;
+
+    std::shared_ptr<TlsStream> tls_;      // Owns the socket while TLS is active
+    TlsContextPtr tlsContext_;
+    std::string sessionKey_;              // host:port, for TlsContext::onNewSession
+#endif
+};
+
+} // namespace asioclient
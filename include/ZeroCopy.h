@@ -0,0 +1,102 @@
+/**
+ * @file ZeroCopy.h
+ * @brief Kernel zero-copy send paths: MSG_ZEROCOPY and sendfile
+ *
+ * Thin wrappers over the Linux system calls; elsewhere the zero-copy calls
+ * report operation_not_supported and file bodies are read with pread().
+ */
+#pragma once
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace asioclient {
+
+using NativeSocket = boost::asio::ip::tcp::socket::native_handle_type;
+
+/**
+ * @class FileBody
+ * @brief Byte range of an open file, sent as a frame body by sendFile()
+ *
+ * Owns its descriptor (opened from a path or dup()ed from the caller's) and
+ * is never modified after construction, so a replayed frame resends the
+ * same range. POSIX only; open() fails with operation_not_supported elsewhere.
+ */
+class FileBody {
+public:
+    FileBody() = default;
+    ~FileBody();
+
+    // Non-copyable
+    FileBody(const FileBody&) = delete;
+    FileBody& operator=(const FileBody&) = delete;
+
+    /**
+     * @brief Open path read-only for [offset, offset + length)
+     * @param length Bytes to send; 0 = to the end of the file
+     * @return false with ec set if the file cannot be opened or is too short
+     */
+    bool open(const std::string& path, uint64_t offset, uint64_t length, boost::system::error_code& ec);
+    bool open(int fd, uint64_t offset, uint64_t length, boost::system::error_code& ec);
+
+    uint64_t offset() const { return offset_; }
+    uint64_t length() const { return length_; }
+
+    /**
+     * @brief Copy bytes [position, position + size) of the range into out
+     * @return Bytes read; 0 with ec set on error or a file truncated under us
+     */
+    size_t read(uint64_t position, char* out, size_t size, boost::system::error_code& ec) const;
+
+    /**
+     * @brief sendfile() bytes [position, position + size) of the range to a socket
+     * @return Bytes sent; 0 with ec would_block when the socket is full
+     */
+    size_t sendTo(NativeSocket socket, uint64_t position, size_t size, boost::system::error_code& ec) const;
+
+    // Whether sendTo() is available on this platform
+    static bool canSendFile();
+
+private:
+    bool adopt(int fd, uint64_t offset, uint64_t length, boost::system::error_code& ec);
+
+    int fd_ = -1;
+    uint64_t offset_ = 0;
+    uint64_t length_ = 0;
+};
+
+using FileBodyPtr = std::shared_ptr<const FileBody>;
+
+namespace zerocopy {
+
+/**
+ * @brief Turn on SO_ZEROCOPY for a connected socket
+ * @return false if the kernel does not support it (the socket is unchanged)
+ */
+bool enable(NativeSocket socket);
+
+/**
+ * @brief One non-blocking sendmsg(MSG_ZEROCOPY) of buffers, skipping `offset` bytes
+ * @return Bytes sent (each call that sends anything uses one completion ID);
+ *         0 with ec would_block when the socket is full, no_buffer_space when
+ *         the kernel cannot pin more pages
+ */
+size_t send(NativeSocket socket, const boost::asio::const_buffer* buffers, size_t count,
+            size_t offset, boost::system::error_code& ec);
+
+/**
+ * @brief Read one completion from the socket error queue
+ * @param last Highest completed ID (ranges complete in order on TCP)
+ * @param copied Set when the kernel fell back to copying
+ * @return false when the queue holds no more completions
+ */
+bool nextCompletion(NativeSocket socket, uint32_t& last, bool& copied);
+
+} // namespace zerocopy
+
+} // namespace asioclient
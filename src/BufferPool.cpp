@@ -0,0 +1,117 @@
+/**
+ * @file BufferPool.cpp
+ * @brief BufferPool implementation
+ */
+
+#include "BufferPool.h"
+#include <algorithm>
+
+namespace asioclient {
+
+BufferPool::BufferPool(const BufferPoolConfig& config) {
+    configure(config);
+}
+
+void BufferPool::configure(const BufferPoolConfig& config) {
+    clear();
+    config_ = config;
+    config_.minBufferSize = roundUpPow2(std::max<size_t>(config_.minBufferSize, 1));
+    config_.maxBufferSize = roundUpPow2(std::max(config_.maxBufferSize, config_.minBufferSize));
+
+    size_t classes = 0;
+    for (size_t size = config_.minBufferSize; size <= config_.maxBufferSize; size <<= 1) {
+        ++classes;
+    }
+    freeLists_.assign(classes, {});
+}
+
+std::vector<char> BufferPool::acquire(size_t size) {
+    std::vector<char> buffer;
+
+    if (!config_.enabled || size > config_.maxBufferSize) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        buffer.resize(size);
+        return buffer;
+    }
+
+    size_t classSize = std::max(roundUpPow2(size), config_.minBufferSize);
+    auto& freeList = freeLists_[classOf(classSize)];
+
+    if (!freeList.empty()) {
+        buffer = std::move(freeList.back());
+        freeList.pop_back();
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        buffersHeld_.fetch_sub(1, std::memory_order_relaxed);
+        bytesHeld_.fetch_sub(buffer.capacity(), std::memory_order_relaxed);
+    } else {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        buffer.reserve(classSize);
+    }
+
+    // Capacity already covers the size class, so this never reallocates
+    buffer.resize(size);
+    return buffer;
+}
+
+void BufferPool::release(std::vector<char>&& buffer) {
+    size_t capacity = buffer.capacity();
+
+    if (!config_.enabled || capacity < config_.minBufferSize ||
+        capacity >= (config_.maxBufferSize << 1)) {
+        if (capacity > 0) {
+            discarded_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    auto& freeList = freeLists_[classOf(capacity)];
+    if (freeList.size() >= config_.maxBuffersPerClass ||
+        bytesHeld_.load(std::memory_order_relaxed) + capacity > config_.maxBytesHeld) {
+        discarded_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Keep the old size: a later acquire() of a similar size then has nothing to zero-fill
+    freeList.push_back(std::move(buffer));
+    recycled_.fetch_add(1, std::memory_order_relaxed);
+    buffersHeld_.fetch_add(1, std::memory_order_relaxed);
+    bytesHeld_.fetch_add(capacity, std::memory_order_relaxed);
+}
+
+void BufferPool::clear() {
+    for (auto& freeList : freeLists_) {
+        freeList.clear();
+    }
+    buffersHeld_.store(0, std::memory_order_relaxed);
+    bytesHeld_.store(0, std::memory_order_relaxed);
+}
+
+BufferPoolStats BufferPool::stats() const {
+    BufferPoolStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.recycled = recycled_.load(std::memory_order_relaxed);
+    stats.discarded = discarded_.load(std::memory_order_relaxed);
+    stats.buffersHeld = buffersHeld_.load(std::memory_order_relaxed);
+    stats.bytesHeld = bytesHeld_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+size_t BufferPool::roundUpPow2(size_t size) {
+    size_t result = 1;
+    while (result < size) {
+        result <<= 1;
+    }
+    return result;
+}
+
+size_t BufferPool::classOf(size_t capacity) const {
+    // Largest size class not exceeding capacity
+    size_t index = 0;
+    for (size_t size = config_.minBufferSize << 1; size <= capacity; size <<= 1) {
+        ++index;
+    }
+    return std::min(index, freeLists_.size() - 1);
+}
+
+} // namespace asioclient
@@ -0,0 +1,86 @@
+/**
+ * @file ClientStats.cpp
+ * @brief Histogram and stats snapshot implementation
+ */
+
+#include "ClientStats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace asioclient {
+
+uint64_t HistogramSnapshot::percentile(double quantile) const {
+    if (count == 0 || buckets.empty()) {
+        return 0;
+    }
+
+    quantile = std::min(std::max(quantile, 0.0), 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * count)));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(LogHistogram::bucketUpperBound(i), max);
+        }
+    }
+    return max;
+}
+
+HistogramSnapshot LogHistogram::snapshot() const {
+    HistogramSnapshot snapshot;
+    snapshot.buckets.resize(kBucketCount);
+
+    // Buckets are read one by one, so derive count from them to keep the
+    // percentiles self-consistent while writers keep recording
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.sum = sum_.load(std::memory_order_relaxed);
+    snapshot.max = max_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+uint64_t LogHistogram::bucketUpperBound(size_t index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+
+    unsigned shift = static_cast<unsigned>(index >> kSubBucketBits) - 1;
+    uint64_t lower = (kSubBuckets + (index & (kSubBuckets - 1))) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+ClientStats StatsCounters::snapshot() const {
+    ClientStats stats;
+    stats.bytesIn = bytesIn.load(std::memory_order_relaxed);
+    stats.bytesOut = bytesOut.load(std::memory_order_relaxed);
+    stats.messagesIn = messagesIn.load(std::memory_order_relaxed);
+    stats.messagesOut = messagesOut.load(std::memory_order_relaxed);
+    stats.messagesRejected = messagesRejected.load(std::memory_order_relaxed);
+    stats.messagesDropped = messagesDropped.load(std::memory_order_relaxed);
+    stats.messagesReplayed = messagesReplayed.load(std::memory_order_relaxed);
+    stats.messagesSpilled = messagesSpilled.load(std::memory_order_relaxed);
+    stats.heartbeatsIn = heartbeatsIn.load(std::memory_order_relaxed);
+    stats.heartbeatsOut = heartbeatsOut.load(std::memory_order_relaxed);
+    stats.zeroCopySends = zeroCopySends.load(std::memory_order_relaxed);
+    stats.zeroCopyCopied = zeroCopyCopied.load(std::memory_order_relaxed);
+    stats.filesSent = filesSent.load(std::memory_order_relaxed);
+    stats.pacedWrites = pacedWrites.load(std::memory_order_relaxed);
+    stats.connects = connects.load(std::memory_order_relaxed);
+    stats.connectFailures = connectFailures.load(std::memory_order_relaxed);
+    stats.reconnects = reconnects.load(std::memory_order_relaxed);
+    stats.disconnects = disconnects.load(std::memory_order_relaxed);
+    stats.tlsHandshakes = tlsHandshakes.load(std::memory_order_relaxed);
+    stats.tlsResumptions = tlsResumptions.load(std::memory_order_relaxed);
+    stats.writeBatchMessages = writeBatchMessages.snapshot();
+    stats.writeBatchBytes = writeBatchBytes.snapshot();
+    stats.queueDepth = queueDepth.snapshot();
+    stats.sendLatency = sendLatency.snapshot();
+    stats.dispatchLatency = dispatchLatency.snapshot();
+    stats.connectDuration = connectDuration.snapshot();
+    return stats;
+}
+
+} // namespace asioclient
@@ -0,0 +1,166 @@
+/**
+ * @file Compression.cpp
+ * @brief FrameCodec implementation
+ */
+
+#include "Compression.h"
+#include "Message.h"
+
+#if defined(ASIOCLIENT_HAS_LZ4)
+    #include <lz4.h>
+#endif
+#if defined(ASIOCLIENT_HAS_ZSTD)
+    #include <zstd.h>
+#endif
+
+namespace asioclient {
+
+/**
+ * @brief Codec state kept for the lifetime of the connection
+ */
+struct FrameCodec::Contexts {
+#if defined(ASIOCLIENT_HAS_LZ4)
+    std::vector<char> lz4State;  // LZ4_sizeofState() bytes, allocated once
+#endif
+#if defined(ASIOCLIENT_HAS_ZSTD)
+    ZSTD_CCtx* zstdCompress = nullptr;
+    ZSTD_DCtx* zstdDecompress = nullptr;
+
+    ~Contexts() {
+        ZSTD_freeCCtx(zstdCompress);
+        ZSTD_freeDCtx(zstdDecompress);
+    }
+#endif
+};
+
+bool compressionAvailable(CompressionCodec codec) {
+    switch (codec) {
+    case CompressionCodec::None:
+        return true;
+    case CompressionCodec::Lz4:
+#if defined(ASIOCLIENT_HAS_LZ4)
+        return true;
+#else
+        return false;
+#endif
+    case CompressionCodec::Zstd:
+#if defined(ASIOCLIENT_HAS_ZSTD)
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+FrameCodec::FrameCodec()
+    : contexts_(std::make_unique<Contexts>())
+{
+}
+
+FrameCodec::~FrameCodec() = default;
+
+void FrameCodec::configure(const CompressionConfig& config) {
+    config_ = config;
+}
+
+bool FrameCodec::compress([[maybe_unused]] const char* data, size_t size, std::vector<char>& out) {
+    if (!wants(size) || size <= COMPRESSION_HEADER_SIZE || out.size() < size) {
+        return false;
+    }
+
+    // Capacity one byte short of the input: a codec that cannot beat it fails
+    // fast instead of producing a useless envelope
+    [[maybe_unused]] char* dst = out.data() + COMPRESSION_HEADER_SIZE;
+    [[maybe_unused]] size_t capacity = size - COMPRESSION_HEADER_SIZE - 1;
+    size_t written = 0;
+
+    switch (config_.codec) {
+#if defined(ASIOCLIENT_HAS_LZ4)
+    case CompressionCodec::Lz4: {
+        if (contexts_->lz4State.empty()) {
+            contexts_->lz4State.resize(static_cast<size_t>(LZ4_sizeofState()));
+        }
+        int result = LZ4_compress_fast_extState(
+            contexts_->lz4State.data(), data, dst, static_cast<int>(size),
+            static_cast<int>(capacity), config_.level > 0 ? config_.level : 1);
+        if (result <= 0) {
+            return false;
+        }
+        written = static_cast<size_t>(result);
+        break;
+    }
+#endif
+#if defined(ASIOCLIENT_HAS_ZSTD)
+    case CompressionCodec::Zstd: {
+        if (!contexts_->zstdCompress) {
+            contexts_->zstdCompress = ZSTD_createCCtx();
+            if (!contexts_->zstdCompress) {
+                return false;
+            }
+        }
+        size_t result = ZSTD_compressCCtx(contexts_->zstdCompress, dst, capacity, data, size,
+                                          config_.level != 0 ? config_.level : ZSTD_CLEVEL_DEFAULT);
+        if (ZSTD_isError(result)) {
+            return false;
+        }
+        written = result;
+        break;
+    }
+#endif
+    default:
+        return false;
+    }
+
+    uint32_t original = static_cast<uint32_t>(size);
+    out[0] = static_cast<char>(config_.codec);
+    for (size_t i = 0; i < 4; ++i) {
+        out[1 + i] = static_cast<char>((original >> (8 * (3 - i))) & 0xff);
+    }
+    out.resize(COMPRESSION_HEADER_SIZE + written);
+    return true;
+}
+
+bool FrameCodec::originalSize(const char* data, size_t size, uint32_t& original) {
+    if (size <= COMPRESSION_HEADER_SIZE) {
+        return false;
+    }
+
+    original = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        original = (original << 8) | static_cast<unsigned char>(data[1 + i]);
+    }
+    return original > 0 && Message::isValidLength(original);
+}
+
+bool FrameCodec::decompress(const char* data, size_t size,
+                            [[maybe_unused]] char* out, [[maybe_unused]] size_t original) {
+    [[maybe_unused]] const char* src = data + COMPRESSION_HEADER_SIZE;
+    [[maybe_unused]] size_t srcSize = size - COMPRESSION_HEADER_SIZE;
+
+    switch (static_cast<CompressionCodec>(data[0])) {
+#if defined(ASIOCLIENT_HAS_LZ4)
+    case CompressionCodec::Lz4: {
+        int result = LZ4_decompress_safe(src, out, static_cast<int>(srcSize),
+                                         static_cast<int>(original));
+        return result >= 0 && static_cast<size_t>(result) == original;
+    }
+#endif
+#if defined(ASIOCLIENT_HAS_ZSTD)
+    case CompressionCodec::Zstd: {
+        if (!contexts_->zstdDecompress) {
+            contexts_->zstdDecompress = ZSTD_createDCtx();
+            if (!contexts_->zstdDecompress) {
+                return false;
+            }
+        }
+        size_t result = ZSTD_decompressDCtx(contexts_->zstdDecompress, out, original, src, srcSize);
+        return !ZSTD_isError(result) && result == original;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+} // namespace asioclient
@@ -0,0 +1,171 @@
+/**
+ * @file Connector.cpp
+ * @brief Connector implementation
+ */
+
+#include "Connector.h"
+#include <algorithm>
+
+namespace asioclient {
+
+Connector::Connector(const asio::any_io_executor& executor, const ConnectConfig& config,
+                     const SocketConfig& socketConfig)
+    : executor_(executor)
+    , config_(config)
+    , socketConfig_(socketConfig)
+    , delayTimer_(executor)
+{
+}
+
+void Connector::start(const asio::ip::tcp::resolver::results_type& endpoints, Handler handler) {
+    handler_ = std::move(handler);
+
+    // Interleave address families, keeping the resolver's preferred family
+    // first (RFC 8305 section 4)
+    std::vector<asio::ip::tcp::endpoint> primary;
+    std::vector<asio::ip::tcp::endpoint> secondary;
+    for (const auto& entry : endpoints) {
+        auto endpoint = entry.endpoint();
+        if (primary.empty() || endpoint.protocol() == primary.front().protocol()) {
+            primary.push_back(endpoint);
+        } else {
+            secondary.push_back(endpoint);
+        }
+    }
+    for (size_t i = 0; i < std::max(primary.size(), secondary.size()); ++i) {
+        if (i < primary.size()) {
+            endpoints_.push_back(primary[i]);
+        }
+        if (i < secondary.size()) {
+            endpoints_.push_back(secondary[i]);
+        }
+    }
+
+    lastError_ = asio::error::host_not_found;
+    startNext();
+}
+
+void Connector::cancel() {
+    finished_ = true;
+    handler_ = nullptr;
+    delayTimer_.cancel();
+
+    for (auto& attempt : attempts_) {
+        boost::system::error_code ignored;
+        attempt->timer.cancel();
+        attempt->socket.close(ignored);
+    }
+}
+
+void Connector::startNext() {
+    if (finished_) {
+        return;
+    }
+
+    if (attempts_.size() >= endpoints_.size()) {
+        if (active_ == 0) {
+            finish();
+        }
+        return;
+    }
+
+    auto self = shared_from_this();
+    size_t index = attempts_.size();
+    attempts_.push_back(std::make_unique<Attempt>(executor_));
+    Attempt& attempt = *attempts_.back();
+    ++active_;
+
+    // Buffer sizes must be in place before the SYN; async_connect keeps an
+    // open socket. A failed open is left for async_connect to report.
+    if (socketConfig_.sendBufferSize > 0 || socketConfig_.receiveBufferSize > 0) {
+        boost::system::error_code ignored;
+        attempt.socket.open(endpoints_[index].protocol(), ignored);
+        if (socketConfig_.sendBufferSize > 0) {
+            attempt.socket.set_option(
+                asio::socket_base::send_buffer_size(socketConfig_.sendBufferSize), ignored);
+        }
+        if (socketConfig_.receiveBufferSize > 0) {
+            attempt.socket.set_option(
+                asio::socket_base::receive_buffer_size(socketConfig_.receiveBufferSize), ignored);
+        }
+    }
+
+    attempt.socket.async_connect(
+        endpoints_[index],
+        [this, self, index](const boost::system::error_code& ec) {
+            onAttemptDone(index, ec);
+        }
+    );
+
+    if (config_.attemptTimeout.count() > 0) {
+        attempt.timer.expires_after(config_.attemptTimeout);
+        attempt.timer.async_wait([this, self, index](const boost::system::error_code& ec) {
+            if (ec || finished_) {
+                return;
+            }
+            Attempt& timedOut = *attempts_[index];
+            timedOut.timedOut = true;
+            boost::system::error_code ignored;
+            timedOut.socket.close(ignored);
+        });
+    }
+
+    // Re-arming cancels the previous delay, so a failure that started this
+    // attempt early also restarts the stagger
+    if (config_.strategy == ConnectStrategy::HappyEyeballs) {
+        delayTimer_.expires_after(config_.attemptDelay);
+        delayTimer_.async_wait([this, self](const boost::system::error_code& ec) {
+            if (!ec) {
+                startNext();
+            }
+        });
+    }
+}
+
+void Connector::onAttemptDone(size_t index, const boost::system::error_code& ec) {
+    Attempt& attempt = *attempts_[index];
+    attempt.timer.cancel();
+    --active_;
+
+    if (finished_) {
+        return;
+    }
+
+    // The timer may have closed the socket after the connect completed but
+    // before this handler ran: that attempt lost, whatever ec says
+    boost::system::error_code result = ec;
+    if (!result && (attempt.timedOut || !attempt.socket.is_open())) {
+        result = asio::error::timed_out;
+    }
+
+    if (!result) {
+        // Winner: cancel the losers and hand the socket over
+        finished_ = true;
+        delayTimer_.cancel();
+        for (size_t i = 0; i < attempts_.size(); ++i) {
+            if (i != index) {
+                boost::system::error_code ignored;
+                attempts_[i]->timer.cancel();
+                attempts_[i]->socket.close(ignored);
+            }
+        }
+        winner_ = index;
+        Handler handler = std::move(handler_);
+        handler(result);
+        return;
+    }
+
+    lastError_ = attempt.timedOut ? boost::system::error_code(asio::error::timed_out) : result;
+
+    // A failed attempt starts the next one right away
+    startNext();
+}
+
+void Connector::finish() {
+    finished_ = true;
+    delayTimer_.cancel();
+    Handler handler = std::move(handler_);
+    handler(lastError_);
+}
+
+} // namespace asioclient
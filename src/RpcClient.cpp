@@ -0,0 +1,184 @@
+/**
+ * @file RpcClient.cpp
+ * @brief RpcClient implementation
+ */
+
+#include "RpcClient.h"
+
+namespace asioclient {
+
+RpcClient::RpcClient(asio::io_context& ioContext)
+    : strand_(asio::make_strand(ioContext))
+    , timerWheel_(TimerWheel::forContext(ioContext))
+    , client_(createClient(ioContext))
+{
+}
+
+RpcClientPtr createRpcClient(asio::io_context& ioContext) {
+    auto rpc = std::make_shared<RpcClient>(ioContext);
+    rpc->attach();
+    return rpc;
+}
+
+void RpcClient::attach() {
+    // The TcpClient may outlive us: its callbacks only hold a weak reference
+    std::weak_ptr<RpcClient> weak = shared_from_this();
+
+    client_->setOnMessageView([weak](const MessageView& view) {
+        if (auto self = weak.lock()) {
+            self->onResponse(view);
+        }
+    });
+
+    client_->setOnDisconnected([weak]() {
+        if (auto self = weak.lock()) {
+            // Unwritten requests are failed by their dropped frames instead
+            self->failAll(asio::error::connection_reset, true);
+            if (self->onDisconnected_) {
+                self->onDisconnected_();
+            }
+        }
+    });
+}
+
+void RpcClient::request(Message message, std::chrono::milliseconds timeout, ResponseHandler handler) {
+    uint64_t id = nextId_.fetch_add(1, std::memory_order_relaxed);
+
+    // Shifted in place: a small request stays in the message's inline storage
+    size_t size = message.bodySize();
+    message.resize(CORRELATION_ID_SIZE + size);
+    if (size > 0) {
+        std::memmove(message.data() + CORRELATION_ID_SIZE, message.data(), size);
+    }
+    Message::encodeCorrelationId(id, message.data());
+
+    // Registered before sending: the response may arrive before send() returns
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PendingRequest pending;
+        pending.handler = std::move(handler);
+        if (timeout.count() > 0) {
+            std::weak_ptr<RpcClient> weak = shared_from_this();
+            pending.deadline = timerWheel_->schedule(timeout, [weak, id]() {
+                if (auto self = weak.lock()) {
+                    self->onDeadline(id);
+                }
+            });
+        }
+        pending_.insert(id, std::move(pending));
+    }
+
+    std::weak_ptr<RpcClient> weak = shared_from_this();
+    auto onSent = [weak, id](boost::system::error_code ec, size_t /*bytes*/) {
+        if (auto self = weak.lock()) {
+            self->onSent(id, ec);
+        }
+    };
+    if (!client_->sendNoReplay(std::move(message), std::move(onSent))) {
+        PendingRequest rejected;
+        bool found;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            found = pending_.erase(id, &rejected);
+            if (found) {
+                timerWheel_->cancel(rejected.deadline);
+            }
+        }
+        if (found) {
+            rejected.handler(asio::error::no_buffer_space, Message());
+        }
+    }
+}
+
+size_t RpcClient::pendingRequests() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+void RpcClient::onResponse(const MessageView& view) {
+    PendingRequest pending;
+    bool found = false;
+
+    if (view.bodySize() >= CORRELATION_ID_SIZE) {
+        uint64_t id = Message::decodeCorrelationId(view.data());
+        std::lock_guard<std::mutex> lock(mutex_);
+        found = pending_.erase(id, &pending);
+        if (found) {
+            timerWheel_->cancel(pending.deadline);
+        }
+    }
+
+    if (found) {
+        Message response;
+        if (view.bodySize() > CORRELATION_ID_SIZE) {
+            response.setBody(view.data() + CORRELATION_ID_SIZE, view.bodySize() - CORRELATION_ID_SIZE);
+        }
+        pending.handler(boost::system::error_code(), std::move(response));
+    } else if (onUnmatched_) {
+        Message msg = view.toMessage();
+        onUnmatched_(msg);
+    }
+}
+
+void RpcClient::onDeadline(uint64_t id) {
+    PendingRequest pending;
+    bool found;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        found = pending_.erase(id, &pending);
+    }
+
+    // Lost the race against the response: nothing to do
+    if (found) {
+        pending.handler(asio::error::timed_out, Message());
+    }
+}
+
+void RpcClient::onSent(uint64_t id, const boost::system::error_code& ec) {
+    PendingRequest pending;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!ec) {
+            // May already be answered: the response can overtake this notice
+            if (PendingRequest* sent = pending_.find(id)) {
+                sent->written = true;
+            }
+            return;
+        }
+        found = pending_.erase(id, &pending);
+        if (found) {
+            timerWheel_->cancel(pending.deadline);
+        }
+    }
+
+    if (found) {
+        pending.handler(ec, Message());
+    }
+}
+
+void RpcClient::failAll(const boost::system::error_code& ec, bool writtenOnly) {
+    std::vector<ResponseHandler> failed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failed.reserve(pending_.size());
+        std::vector<std::pair<uint64_t, PendingRequest>> kept;
+        pending_.drain([this, &failed, &kept, writtenOnly](uint64_t id, PendingRequest&& pending) {
+            if (writtenOnly && !pending.written) {
+                kept.emplace_back(id, std::move(pending));
+                return;
+            }
+            timerWheel_->cancel(pending.deadline);
+            failed.push_back(std::move(pending.handler));
+        });
+        for (auto& entry : kept) {
+            pending_.insert(entry.first, std::move(entry.second));
+        }
+    }
+
+    for (auto& handler : failed) {
+        handler(ec, Message());
+    }
+}
+
+} // namespace asioclient
@@ -0,0 +1,168 @@
+/**
+ * @file SpillFile.cpp
+ * @brief SpillFile implementation
+ */
+
+#include "SpillFile.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace ipc = boost::interprocess;
+
+namespace asioclient {
+
+struct SpillFile::Mapping {
+    ipc::file_mapping file;
+    ipc::mapped_region region;
+};
+
+SpillFile::SpillFile() = default;
+
+SpillFile::~SpillFile() {
+    close();
+}
+
+bool SpillFile::open(const std::string& path, size_t capacity, boost::system::error_code& ec) {
+    close();
+    ec.clear();
+    if (capacity < RECORD_PREFIX) {
+        ec = boost::system::errc::make_error_code(boost::system::errc::invalid_argument);
+        return false;
+    }
+
+    // Sized once and left sparse: pages are only allocated as records land
+    {
+        std::ofstream create(path, std::ios::binary | std::ios::trunc);
+        if (!create) {
+            ec = boost::system::errc::make_error_code(boost::system::errc::io_error);
+            return false;
+        }
+    }
+    std::error_code resizeError;
+    std::filesystem::resize_file(path, capacity, resizeError);
+    if (resizeError) {
+        ec = boost::system::error_code(resizeError.value(), boost::system::system_category());
+        std::filesystem::remove(path, resizeError);
+        return false;
+    }
+
+    try {
+        auto mapping = std::make_unique<Mapping>();
+        mapping->file = ipc::file_mapping(path.c_str(), ipc::read_write);
+        mapping->region = ipc::mapped_region(mapping->file, ipc::read_write, 0, capacity);
+        data_ = static_cast<char*>(mapping->region.get_address());
+        mapping_ = std::move(mapping);
+    } catch (const ipc::interprocess_exception& e) {
+        ec = e.get_native_error() != 0
+            ? boost::system::error_code(e.get_native_error(), boost::system::system_category())
+            : boost::system::errc::make_error_code(boost::system::errc::io_error);
+        std::filesystem::remove(path, resizeError);
+        return false;
+    }
+
+    path_ = path;
+    capacity_ = capacity;
+    clear();
+    return true;
+}
+
+void SpillFile::close() {
+    if (!mapping_) {
+        return;
+    }
+
+    mapping_.reset();
+    data_ = nullptr;
+    capacity_ = 0;
+    clear();
+
+    std::error_code ignored;
+    std::filesystem::remove(path_, ignored);
+    path_.clear();
+}
+
+bool SpillFile::push(int64_t stamp, const char* header, size_t headerSize,
+                     const char* body, size_t size) {
+    size_t record = RECORD_PREFIX + headerSize + size;
+    if (!data_ || headerSize > 0xFF || record > capacity_ - used_) {
+        return false;
+    }
+
+    uint64_t bodySize = size;
+    uint8_t headerLength = static_cast<uint8_t>(headerSize);
+    size_t tail = (head_ + used_) % capacity_;
+    writeAt(tail, &stamp, sizeof(stamp));
+    tail = (tail + sizeof(stamp)) % capacity_;
+    writeAt(tail, &bodySize, sizeof(bodySize));
+    tail = (tail + sizeof(bodySize)) % capacity_;
+    writeAt(tail, &headerLength, 1);
+    tail = (tail + 1) % capacity_;
+    writeAt(tail, header, headerSize);
+    tail = (tail + headerSize) % capacity_;
+    writeAt(tail, body, size);
+
+    used_ += record;
+    ++records_;
+    return true;
+}
+
+bool SpillFile::pop(int64_t& stamp, char* header, size_t& headerSize,
+                    std::vector<char>& body) {
+    if (records_ == 0) {
+        return false;
+    }
+
+    uint64_t bodySize = 0;
+    uint8_t headerLength = 0;
+    size_t offset = head_;
+    readAt(offset, &stamp, sizeof(stamp));
+    offset = (offset + sizeof(stamp)) % capacity_;
+    readAt(offset, &bodySize, sizeof(bodySize));
+    offset = (offset + sizeof(bodySize)) % capacity_;
+    readAt(offset, &headerLength, 1);
+    offset = (offset + 1) % capacity_;
+    readAt(offset, header, headerLength);
+    offset = (offset + headerLength) % capacity_;
+
+    size_t size = static_cast<size_t>(bodySize);
+    body.resize(size);
+    readAt(offset, body.data(), size);
+
+    headerSize = headerLength;
+    size_t record = RECORD_PREFIX + headerLength + size;
+    head_ = (head_ + record) % capacity_;
+    used_ -= record;
+    --records_;
+    return true;
+}
+
+void SpillFile::clear() {
+    head_ = 0;
+    used_ = 0;
+    records_ = 0;
+}
+
+void SpillFile::writeAt(size_t offset, const void* data, size_t size) {
+    // A record may wrap around the end of the ring
+    if (size == 0) {
+        return;
+    }
+    size_t first = std::min(size, capacity_ - offset);
+    std::memcpy(data_ + offset, data, first);
+    std::memcpy(data_, static_cast<const char*>(data) + first, size - first);
+}
+
+void SpillFile::readAt(size_t offset, void* data, size_t size) const {
+    if (size == 0) {
+        return;
+    }
+    size_t first = std::min(size, capacity_ - offset);
+    std::memcpy(data, data_ + offset, first);
+    std::memcpy(static_cast<char*>(data) + first, data_, size - first);
+}
+
+} // namespace asioclient
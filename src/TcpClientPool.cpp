@@ -0,0 +1,266 @@
+/**
+ * @file TcpClientPool.cpp
+ * @brief TcpClientPool implementation
+ */
+
+#include "TcpClientPool.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#elif defined(_WIN32)
+    #include <windows.h>
+#endif
+
+namespace asioclient {
+
+namespace {
+
+// splitmix64 finalizer: spreads sequential keys over the ring
+uint64_t mix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+TcpClientPool::TcpClientPool(const PoolConfig& config)
+    : config_(config)
+{
+    size_t threads = config_.threads;
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    for (size_t i = 0; i < threads; ++i) {
+        // Concurrency hint 1: each context is only ever run by its own thread
+        contexts_.push_back(std::make_unique<asio::io_context>(1));
+        workGuards_.push_back(asio::make_work_guard(*contexts_.back()));
+    }
+
+    for (size_t i = 0; i < threads; ++i) {
+        asio::io_context& ioContext = *contexts_[i];
+        threads_.emplace_back([&ioContext]() {
+            ioContext.run();
+        });
+        if (config_.pinThreads) {
+            pinThread(threads_.back(), i % cores);
+        }
+    }
+}
+
+TcpClientPool::~TcpClientPool() {
+    disconnect();
+
+    // Let the aborted handlers drain, then join
+    workGuards_.clear();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    // No IO thread is left, so the callbacks can be dropped without a race
+    for (auto& client : clients_) {
+        client->setOnConnected(nullptr);
+        client->setOnDisconnected(nullptr);
+        client->setOnMessage(nullptr);
+        client->setOnError(nullptr);
+    }
+}
+
+void TcpClientPool::connect(const std::string& host, uint16_t port) {
+    connect({{host, port}});
+}
+
+void TcpClientPool::connect(const std::vector<std::pair<std::string, uint16_t>>& endpoints) {
+    std::vector<std::pair<TcpClientPtr, const std::pair<std::string, uint16_t>*>> added;
+
+    for (const auto& endpoint : endpoints) {
+        uint64_t endpointHash = hashKey(endpoint.first + ":" + std::to_string(endpoint.second));
+
+        for (size_t i = 0; i < config_.connectionsPerEndpoint; ++i) {
+            size_t shard;
+            if (config_.placement == PoolPlacement::EndpointHash) {
+                shard = static_cast<size_t>((endpointHash + i) % contexts_.size());
+            } else {
+                shard = nextShard_++ % contexts_.size();
+            }
+            added.emplace_back(addClient(shard), &endpoint);
+        }
+    }
+
+    rebuildRing();
+
+    // Connect only once every client is registered, so routing never sees a
+    // partially built pool
+    for (const auto& entry : added) {
+        entry.first->connect(entry.second->first, entry.second->second);
+    }
+}
+
+void TcpClientPool::disconnect() {
+    for (auto& client : clients_) {
+        client->disconnect();
+    }
+}
+
+TcpClientPtr TcpClientPool::addClient(size_t shard) {
+    auto client = createClient(*contexts_[shard]);
+    size_t index = clients_.size();
+
+    client->setReconnectConfig(config_.reconnect);
+    client->setConnectConfig(config_.connect);
+    client->setWriteConfig(config_.write);
+    client->setPacingConfig(config_.pacing);
+    client->setReadConfig(config_.read);
+    client->setTimeoutConfig(config_.timeout);
+    client->setHeartbeatConfig(config_.heartbeat);
+    client->setTcpKeepaliveConfig(config_.tcpKeepalive);
+    client->setSocketConfig(config_.socket);
+    ReplayConfig replay = config_.replay;
+    if (!replay.spillPath.empty()) {
+        replay.spillPath += "." + std::to_string(index);
+    }
+    client->setReplayConfig(replay);
+    client->setBufferPoolConfig(config_.bufferPool);
+    client->setCompressionConfig(config_.compression);
+    client->setStatsConfig(config_.stats);
+#if defined(ASIOCLIENT_HAS_TLS)
+    client->setTlsContext(config_.tls);
+#endif
+    if (config_.configureClient) {
+        config_.configureClient(index, *client);
+    }
+
+    client->setOnConnected([this, index]() {
+        if (onConnected_) {
+            onConnected_(index);
+        }
+    });
+    client->setOnDisconnected([this, index]() {
+        if (onDisconnected_) {
+            onDisconnected_(index);
+        }
+    });
+    client->setOnMessage([this, index](Message& msg) {
+        if (onMessage_) {
+            onMessage_(index, msg);
+        }
+    });
+    client->setOnError([this, index](const boost::system::error_code& ec) {
+        if (onError_) {
+            onError_(index, ec);
+        }
+    });
+
+    clients_.push_back(client);
+    return client;
+}
+
+size_t TcpClientPool::route(uint64_t key) {
+    if (clients_.empty()) {
+        throw std::logic_error("TcpClientPool: no connections");
+    }
+
+    switch (config_.routing) {
+        case PoolRouting::ConsistentHash: {
+            // First ring point at or after the key; skip points of connections
+            // that are down so their keys move to the next one on the ring
+            uint64_t h = mix64(key);
+            auto it = std::lower_bound(
+                ring_.begin(), ring_.end(), std::make_pair(h, size_t(0)));
+            for (size_t n = 0; n < ring_.size(); ++n, ++it) {
+                if (it == ring_.end()) {
+                    it = ring_.begin();
+                }
+                if (clients_[it->second]->isConnected()) {
+                    return it->second;
+                }
+            }
+            // Nothing connected: keep the home connection, it queues until reconnect
+            it = std::lower_bound(ring_.begin(), ring_.end(), std::make_pair(h, size_t(0)));
+            return it == ring_.end() ? ring_.front().second : it->second;
+        }
+
+        case PoolRouting::LeastQueuedBytes: {
+            size_t best = 0;
+            size_t bestBytes = std::numeric_limits<size_t>::max();
+            bool bestConnected = false;
+            for (size_t i = 0; i < clients_.size(); ++i) {
+                bool connected = clients_[i]->isConnected();
+                size_t bytes = clients_[i]->queuedBytes();
+                if ((connected && !bestConnected) ||
+                    (connected == bestConnected && bytes < bestBytes)) {
+                    best = i;
+                    bestBytes = bytes;
+                    bestConnected = connected;
+                }
+            }
+            return best;
+        }
+
+        case PoolRouting::RoundRobin:
+        default:
+            return roundRobin_.fetch_add(1, std::memory_order_relaxed) % clients_.size();
+    }
+}
+
+size_t TcpClientPool::connectedCount() const {
+    return static_cast<size_t>(std::count_if(
+        clients_.begin(), clients_.end(),
+        [](const TcpClientPtr& client) { return client->isConnected(); }));
+}
+
+size_t TcpClientPool::queuedBytes() const {
+    size_t total = 0;
+    for (const auto& client : clients_) {
+        total += client->queuedBytes();
+    }
+    return total;
+}
+
+uint64_t TcpClientPool::hashKey(std::string_view key) {
+    // FNV-1a 64
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : key) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+void TcpClientPool::rebuildRing() {
+    ring_.clear();
+    size_t points = std::max<size_t>(config_.virtualNodes, 1);
+    ring_.reserve(clients_.size() * points);
+
+    for (size_t i = 0; i < clients_.size(); ++i) {
+        for (size_t v = 0; v < points; ++v) {
+            ring_.emplace_back(mix64((static_cast<uint64_t>(i) << 32) | v), i);
+        }
+    }
+    std::sort(ring_.begin(), ring_.end());
+}
+
+void TcpClientPool::pinThread(std::thread& thread, size_t cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#elif defined(_WIN32)
+    SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << cpu);
+#else
+    (void)thread;
+    (void)cpu;
+#endif
+}
+
+} // namespace asioclient
@@ -0,0 +1,314 @@
+/**
+ * @file TimerWheel.cpp
+ * @brief TimerWheel implementation
+ */
+
+#include "TimerWheel.h"
+#include <algorithm>
+
+namespace asioclient {
+
+namespace {
+
+/**
+ * @brief Owns the per-io_context wheel and tears it down on shutdown
+ */
+class TimerWheelService : public asio::io_context::service {
+public:
+    static asio::io_context::id id;
+
+    explicit TimerWheelService(asio::io_context& ioContext)
+        : asio::io_context::service(ioContext) {}
+
+    TimerWheelPtr get(asio::io_context& ioContext, std::chrono::milliseconds tick) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!wheel_) {
+            wheel_ = std::make_shared<TimerWheel>(ioContext, tick);
+        }
+        return wheel_;
+    }
+
+private:
+    void shutdown() override {
+        TimerWheelPtr wheel;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            wheel.swap(wheel_);
+        }
+        if (wheel) {
+            wheel->shutdown();
+        }
+    }
+
+    std::mutex mutex_;
+    TimerWheelPtr wheel_;
+};
+
+asio::io_context::id TimerWheelService::id;
+
+constexpr uint64_t kRange = uint64_t(1) << (TimerWheel::kSlotBits * TimerWheel::kLevels);
+
+} // namespace
+
+TimerWheel::TimerWheel(asio::io_context& ioContext, std::chrono::milliseconds tick)
+    : strand_(asio::make_strand(ioContext))
+    , timer_(std::make_unique<asio::steady_timer>(strand_))
+    , tick_(std::max(tick, std::chrono::milliseconds(1)))
+    , epoch_(Clock::now())
+    , heads_(kLevels * kSlots, kNil)
+{
+}
+
+TimerWheelPtr TimerWheel::forContext(asio::io_context& ioContext, std::chrono::milliseconds tick) {
+    return asio::use_service<TimerWheelService>(ioContext).get(ioContext, tick);
+}
+
+TimerWheel::TimerId TimerWheel::schedule(std::chrono::nanoseconds delay, Callback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+        return 0;
+    }
+
+    // Nothing pending means nothing to cascade: jump straight to now
+    if (count_ == 0) {
+        currentTick_ = tickAt(Clock::now());
+    }
+
+    uint32_t index = allocate();
+    Node& node = nodes_[index];
+    node.deadline = std::max(tickAt(Clock::now() + delay) + 1, currentTick_ + 1);
+    node.callback = std::move(callback);
+    link(index);
+    ++count_;
+
+    // Re-arm when idle or when this timer is due before the current wakeup
+    if (!armed_ || node.deadline < armedTick_) {
+        armed_ = true;
+        armedTick_ = node.deadline;
+        auto self = shared_from_this();
+        asio::post(strand_, [self]() {
+            self->arm();
+        });
+    }
+
+    return (static_cast<uint64_t>(node.generation) << 32) | (index + 1);
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    if (id == 0) {
+        return false;
+    }
+
+    Callback callback;  // Destroyed after the lock is released
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t index = static_cast<uint32_t>(id & 0xffffffffu) - 1;
+    if (index >= nodes_.size() || !nodes_[index].linked ||
+        nodes_[index].generation != static_cast<uint32_t>(id >> 32)) {
+        return false;
+    }
+
+    unlink(index);
+    callback = std::move(nodes_[index].callback);
+    release(index);
+    --count_;
+    return true;
+}
+
+size_t TimerWheel::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+}
+
+void TimerWheel::shutdown() {
+    std::vector<Node> nodes;
+    std::unique_ptr<asio::steady_timer> timer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        nodes.swap(nodes_);
+        freeList_.clear();
+        std::fill(heads_.begin(), heads_.end(), kNil);
+        count_ = 0;
+        timer.swap(timer_);
+    }
+    // Callbacks (and anything they capture) are released outside the lock
+}
+
+uint64_t TimerWheel::tickAt(Clock::time_point when) const {
+    if (when <= epoch_) {
+        return 0;
+    }
+    return static_cast<uint64_t>((when - epoch_) / tick_);
+}
+
+void TimerWheel::link(uint32_t index) {
+    Node& node = nodes_[index];
+    uint64_t delta = node.deadline - currentTick_;
+
+    // Level L holds deadlines less than 64^(L+1) ticks away, slotted by the
+    // deadline bits of that level; beyond the range, park in the last level
+    uint64_t position = delta < kRange ? node.deadline : currentTick_ + kRange - 1;
+    size_t level = 0;
+    while (level + 1 < kLevels && delta >= (uint64_t(1) << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+    size_t slot = static_cast<size_t>(position >> (kSlotBits * level)) & (kSlots - 1);
+
+    node.list = static_cast<uint16_t>(level * kSlots + slot);
+    node.prev = kNil;
+    node.next = heads_[node.list];
+    if (node.next != kNil) {
+        nodes_[node.next].prev = index;
+    }
+    heads_[node.list] = index;
+    node.linked = true;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    Node& node = nodes_[index];
+    if (node.prev != kNil) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[node.list] = node.next;
+    }
+    if (node.next != kNil) {
+        nodes_[node.next].prev = node.prev;
+    }
+    node.prev = kNil;
+    node.next = kNil;
+    node.linked = false;
+}
+
+uint32_t TimerWheel::allocate() {
+    if (!freeList_.empty()) {
+        uint32_t index = freeList_.back();
+        freeList_.pop_back();
+        return index;
+    }
+    nodes_.emplace_back();
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void TimerWheel::release(uint32_t index) {
+    nodes_[index].callback = nullptr;
+    ++nodes_[index].generation;
+    freeList_.push_back(index);
+}
+
+void TimerWheel::cascade(size_t level, uint64_t tick) {
+    size_t list = level * kSlots + (static_cast<size_t>(tick >> (kSlotBits * level)) & (kSlots - 1));
+    uint32_t index = heads_[list];
+    heads_[list] = kNil;
+
+    while (index != kNil) {
+        uint32_t next = nodes_[index].next;
+        link(index);  // Lands on a lower level relative to currentTick_
+        index = next;
+    }
+}
+
+uint64_t TimerWheel::nextEvent() const {
+    // First tick after currentTick_ whose level-0 slot is occupied; level 0
+    // only holds deadlines less than kSlots ticks away
+    uint64_t next = UINT64_MAX;
+    for (uint64_t tick = currentTick_ + 1; tick <= currentTick_ + kSlots; ++tick) {
+        if (heads_[static_cast<size_t>(tick) & (kSlots - 1)] != kNil) {
+            next = tick;
+            break;
+        }
+    }
+
+    // First boundary of each higher level that cascades an occupied slot
+    for (size_t level = 1; level < kLevels; ++level) {
+        unsigned shift = kSlotBits * static_cast<unsigned>(level);
+        uint64_t boundary = ((currentTick_ >> shift) + 1) << shift;
+        for (size_t i = 0; i < kSlots && boundary < next; ++i, boundary += uint64_t(1) << shift) {
+            size_t slot = static_cast<size_t>(boundary >> shift) & (kSlots - 1);
+            if (heads_[level * kSlots + slot] != kNil) {
+                next = boundary;
+                break;
+            }
+        }
+    }
+    return next;
+}
+
+void TimerWheel::advance(uint64_t target, std::vector<Callback>& expired) {
+    while (currentTick_ < target && count_ > 0) {
+        // Skip straight to the next tick with anything to expire or cascade
+        currentTick_ = std::min(nextEvent(), target);
+
+        // Pull down the higher-level slot that starts at this tick
+        for (size_t level = 1; level < kLevels; ++level) {
+            if ((currentTick_ & ((uint64_t(1) << (kSlotBits * level)) - 1)) != 0) {
+                break;
+            }
+            cascade(level, currentTick_);
+        }
+
+        size_t list = static_cast<size_t>(currentTick_) & (kSlots - 1);
+        uint32_t index = heads_[list];
+        heads_[list] = kNil;
+        while (index != kNil) {
+            uint32_t next = nodes_[index].next;
+            nodes_[index].linked = false;
+            if (nodes_[index].deadline <= currentTick_) {
+                expired.push_back(std::move(nodes_[index].callback));
+                release(index);
+                --count_;
+            } else {
+                link(index);  // Parked beyond the wheel range
+            }
+            index = next;
+        }
+    }
+
+    if (count_ == 0) {
+        currentTick_ = std::max(currentTick_, target);
+    }
+}
+
+void TimerWheel::arm() {
+    uint64_t next;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!timer_ || !armed_) {
+            return;
+        }
+        if (count_ == 0) {
+            armed_ = false;  // Everything was cancelled before the wakeup
+            return;
+        }
+        next = nextEvent();
+        armedTick_ = next;
+    }
+
+    auto self = shared_from_this();
+    timer_->expires_at(epoch_ + tick_ * static_cast<int64_t>(next));
+    timer_->async_wait([self](const boost::system::error_code& ec) {
+        if (!ec) {
+            self->onTick();
+        }
+    });
+}
+
+void TimerWheel::onTick() {
+    std::vector<Callback> expired;
+    bool rearm;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        advance(tickAt(Clock::now()), expired);
+        rearm = count_ > 0 && !stopped_;
+        armed_ = rearm;
+    }
+
+    for (auto& callback : expired) {
+        callback();
+    }
+
+    if (rearm) {
+        arm();
+    }
+}
+
+} // namespace asioclient
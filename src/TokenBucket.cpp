@@ -0,0 +1,83 @@
+/**
+ * @file TokenBucket.cpp
+ * @brief TokenBucket implementation
+ */
+
+#include "TokenBucket.h"
+#include <algorithm>
+
+namespace asioclient {
+
+TokenBucket::TokenBucket(double rate, double burst)
+    : rate_(rate)
+    , burst_(std::max(burst, 1.0))
+    , tokens_(burst_)
+    , last_(Clock::now())
+{
+}
+
+std::chrono::nanoseconds TokenBucket::reserve(double tokens) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (rate_ <= 0) {
+        return std::chrono::nanoseconds(0);
+    }
+
+    refill(Clock::now());
+    tokens_ -= tokens;
+    if (tokens_ >= 0) {
+        return std::chrono::nanoseconds(0);
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(-tokens_ / rate_));
+}
+
+bool TokenBucket::tryAcquire(double tokens) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (rate_ <= 0) {
+        return true;
+    }
+
+    refill(Clock::now());
+    if (tokens_ < tokens) {
+        return false;
+    }
+    tokens_ -= tokens;
+    return true;
+}
+
+void TokenBucket::setRate(double rate, double burst) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    refill(Clock::now());
+    rate_ = rate;
+    burst_ = std::max(burst, 1.0);
+    tokens_ = std::min(tokens_, burst_);
+}
+
+double TokenBucket::rate() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rate_;
+}
+
+double TokenBucket::burst() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return burst_;
+}
+
+double TokenBucket::available() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (rate_ <= 0) {
+        return tokens_;
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - last_).count();
+    return std::min(burst_, tokens_ + std::max(elapsed, 0.0) * rate_);
+}
+
+void TokenBucket::refill(Clock::time_point now) {
+    if (rate_ > 0 && now > last_) {
+        double elapsed = std::chrono::duration<double>(now - last_).count();
+        tokens_ = std::min(burst_, tokens_ + elapsed * rate_);
+    }
+    last_ = now;
+}
+
+} // namespace asioclient
@@ -0,0 +1,144 @@
+/**
+ * @file Transport.cpp
+ * @brief Transport and TlsContext implementation
+ */
+
+#include "Transport.h"
+
+namespace asioclient {
+
+#if defined(ASIOCLIENT_HAS_TLS)
+
+namespace {
+
+// SSL ex_data slot pointing back at the owning Transport (app_data belongs to Asio)
+int transportIndex() {
+    static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    return index;
+}
+
+} // namespace
+
+TlsContext::TlsContext(asio::ssl::context::method method)
+    : context_(method)
+{
+    // Client-side caching only, kept here per endpoint instead of in OpenSSL's
+    // table, which clients never look up
+    SSL_CTX* native = context_.native_handle();
+    SSL_CTX_set_session_cache_mode(native, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(native, &TlsContext::onNewSession);
+}
+
+size_t TlsContext::cachedSessions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sessions_.size();
+}
+
+void TlsContext::clearSessions() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sessions_.clear();
+}
+
+TlsContext::SessionPtr TlsContext::findSession(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(key);
+    return it != sessions_.end() ? it->second : SessionPtr();
+}
+
+void TlsContext::storeSession(const std::string& key, SSL_SESSION* session) {
+    SessionPtr entry(session, SSL_SESSION_free);
+    std::lock_guard<std::mutex> lock(mutex_);
+    sessions_[key] = std::move(entry);
+}
+
+int TlsContext::onNewSession(SSL* ssl, SSL_SESSION* session) {
+    // Runs inside the handshake or a read (TLS 1.3 tickets follow the handshake)
+    auto* transport = static_cast<Transport*>(SSL_get_ex_data(ssl, transportIndex()));
+    if (!transport || !transport->tlsContext_ || !transport->tlsContext_->sessionResumption()) {
+        return 0;
+    }
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+    // Keep a copy: OpenSSL marks the live session not resumable when its
+    // connection dies without close_notify, exactly the reconnect case
+    if (SSL_SESSION* copy = SSL_SESSION_dup(session)) {
+        transport->tlsContext_->storeSession(transport->sessionKey_, copy);
+    }
+    return 0;
+#else
+    transport->tlsContext_->storeSession(transport->sessionKey_, session);
+    return 1;  // The cache now holds the reference
+#endif
+}
+
+#endif // ASIOCLIENT_HAS_TLS
+
+Transport::Transport(const executor_type& executor)
+    : executor_(executor)
+    , socket_(executor)
+{
+}
+
+Transport::Socket& Transport::socket() {
+#if defined(ASIOCLIENT_HAS_TLS)
+    if (tls_) {
+        return tls_->next_layer();
+    }
+#endif
+    return socket_;
+}
+
+void Transport::assign(Socket&& socket) {
+#if defined(ASIOCLIENT_HAS_TLS)
+    if (tls_) {
+        // Operations still unwinding on the old stream hold their own reference
+        SSL_set_ex_data(tls_->native_handle(), transportIndex(), nullptr);
+        tls_.reset();
+    }
+#endif
+    socket_ = std::move(socket);
+}
+
+bool Transport::isTls() const {
+#if defined(ASIOCLIENT_HAS_TLS)
+    return tls_ != nullptr;
+#else
+    return false;
+#endif
+}
+
+#if defined(ASIOCLIENT_HAS_TLS)
+
+void Transport::startTls(const TlsContextPtr& context, const std::string& host, uint16_t port) {
+    tlsContext_ = context;
+    sessionKey_ = host + ":" + std::to_string(port);
+    tls_ = std::make_shared<TlsStream>(std::move(socket_), context->context());
+
+    SSL* ssl = tls_->native_handle();
+    SSL_set_ex_data(ssl, transportIndex(), this);
+
+    // SNI and certificate name checks only make sense for host names
+    boost::system::error_code ec;
+    asio::ip::make_address(host, ec);
+    if (ec) {
+        SSL_set_tlsext_host_name(ssl, host.c_str());
+    }
+    tls_->set_verify_callback(asio::ssl::host_name_verification(host));
+
+    if (context->sessionResumption()) {
+        if (auto session = context->findSession(sessionKey_)) {
+            SSL_set_session(ssl, session.get());
+        }
+    }
+}
+
+bool Transport::sessionReused() const {
+    return tls_ && SSL_session_reused(tls_->native_handle()) == 1;
+}
+
+#endif // ASIOCLIENT_HAS_TLS
+
+void Transport::close(boost::system::error_code& ec) {
+    socket().close(ec);
+}
+
+} // namespace asioclient
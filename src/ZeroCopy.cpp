@@ -0,0 +1,288 @@
+/**
+ * @file ZeroCopy.cpp
+ * @brief FileBody and MSG_ZEROCOPY implementation
+ */
+
+#include "ZeroCopy.h"
+#include <algorithm>
+#include <cerrno>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__linux__)
+    #include <linux/errqueue.h>
+    #include <csignal>
+    #include <ctime>
+    #include <netinet/in.h>
+    #include <pthread.h>
+    #include <sys/sendfile.h>
+#endif
+
+namespace asioclient {
+
+namespace {
+
+boost::system::error_code lastError() {
+    return boost::system::error_code(errno, boost::system::system_category());
+}
+
+// Only the fallbacks use it, and Linux with MSG_ZEROCOPY has none
+#if !defined(__linux__) || !defined(MSG_ZEROCOPY)
+boost::system::error_code notSupported() {
+    return boost::system::errc::make_error_code(boost::system::errc::operation_not_supported);
+}
+#endif
+
+} // namespace
+
+FileBody::~FileBody() {
+#if !defined(_WIN32)
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+#endif
+}
+
+bool FileBody::open(const std::string& path, uint64_t offset, uint64_t length,
+                    boost::system::error_code& ec) {
+#if !defined(_WIN32)
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        ec = lastError();
+        return false;
+    }
+    return adopt(fd, offset, length, ec);
+#else
+    (void)path; (void)offset; (void)length;
+    ec = notSupported();
+    return false;
+#endif
+}
+
+bool FileBody::open(int fd, uint64_t offset, uint64_t length, boost::system::error_code& ec) {
+#if !defined(_WIN32)
+    // Our own descriptor: the caller may close theirs right away
+    int own = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (own < 0) {
+        ec = lastError();
+        return false;
+    }
+    return adopt(own, offset, length, ec);
+#else
+    (void)fd; (void)offset; (void)length;
+    ec = notSupported();
+    return false;
+#endif
+}
+
+bool FileBody::adopt(int fd, uint64_t offset, uint64_t length, boost::system::error_code& ec) {
+#if !defined(_WIN32)
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ec = lastError();
+        ::close(fd);
+        return false;
+    }
+
+    uint64_t size = static_cast<uint64_t>(st.st_size);
+    if (offset > size || (length > 0 && length > size - offset)) {
+        ec = boost::system::errc::make_error_code(boost::system::errc::invalid_argument);
+        ::close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    offset_ = offset;
+    length_ = length > 0 ? length : size - offset;
+    ec.clear();
+    return true;
+#else
+    (void)fd; (void)offset; (void)length;
+    ec = notSupported();
+    return false;
+#endif
+}
+
+size_t FileBody::read(uint64_t position, char* out, size_t size, boost::system::error_code& ec) const {
+#if !defined(_WIN32)
+    ssize_t n;
+    do {
+        n = ::pread(fd_, out, size, static_cast<off_t>(offset_ + position));
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) {
+        ec = lastError();
+        return 0;
+    }
+    if (n == 0 && size > 0) {
+        ec = boost::asio::error::eof;  // Truncated since open()
+        return 0;
+    }
+    ec.clear();
+    return static_cast<size_t>(n);
+#else
+    (void)position; (void)out; (void)size;
+    ec = notSupported();
+    return 0;
+#endif
+}
+
+size_t FileBody::sendTo(NativeSocket socket, uint64_t position, size_t size,
+                        boost::system::error_code& ec) const {
+#if defined(__linux__)
+    // sendfile() has no MSG_NOSIGNAL: block SIGPIPE on this thread for the
+    // call and swallow one raised by it, leaving the process disposition alone
+    sigset_t pipe, previous;
+    sigemptyset(&pipe);
+    sigaddset(&pipe, SIGPIPE);
+    sigset_t pending;
+    sigpending(&pending);
+    bool alreadyPending = sigismember(&pending, SIGPIPE) == 1;
+    pthread_sigmask(SIG_BLOCK, &pipe, &previous);
+
+    off_t offset = static_cast<off_t>(offset_ + position);
+    ssize_t n;
+    do {
+        n = ::sendfile(socket, fd_, &offset, size);
+    } while (n < 0 && errno == EINTR);
+    int error = errno;
+
+    if (n < 0 && error == EPIPE && !alreadyPending) {
+        timespec zero{0, 0};
+        while (sigtimedwait(&pipe, nullptr, &zero) < 0 && errno == EINTR) {
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+    errno = error;
+
+    if (n < 0) {
+        ec = (errno == EAGAIN || errno == EWOULDBLOCK) ? boost::asio::error::would_block : lastError();
+        return 0;
+    }
+    if (n == 0 && size > 0) {
+        ec = boost::asio::error::eof;
+        return 0;
+    }
+    ec.clear();
+    return static_cast<size_t>(n);
+#else
+    (void)socket; (void)position; (void)size;
+    ec = notSupported();
+    return 0;
+#endif
+}
+
+bool FileBody::canSendFile() {
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+namespace zerocopy {
+
+bool enable(NativeSocket socket) {
+#if defined(__linux__) && defined(SO_ZEROCOPY)
+    int one = 1;
+    return ::setsockopt(socket, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == 0;
+#else
+    (void)socket;
+    return false;
+#endif
+}
+
+size_t send(NativeSocket socket, const boost::asio::const_buffer* buffers, size_t count,
+            size_t offset, boost::system::error_code& ec) {
+#if defined(__linux__) && defined(MSG_ZEROCOPY)
+    constexpr size_t kMaxIov = 16;
+    iovec iov[kMaxIov];
+    size_t used = 0;
+    for (size_t i = 0; i < count && used < kMaxIov; ++i) {
+        size_t size = buffers[i].size();
+        if (offset >= size) {
+            offset -= size;
+            continue;
+        }
+        iov[used].iov_base = const_cast<char*>(static_cast<const char*>(buffers[i].data()) + offset);
+        iov[used].iov_len = size - offset;
+        offset = 0;
+        ++used;
+    }
+
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = used;
+
+    ssize_t n;
+    do {
+        n = ::sendmsg(socket, &msg, MSG_ZEROCOPY | MSG_NOSIGNAL | MSG_DONTWAIT);
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            ec = boost::asio::error::would_block;
+        } else if (errno == ENOBUFS) {
+            ec = boost::asio::error::no_buffer_space;
+        } else {
+            ec = lastError();
+        }
+        return 0;
+    }
+    ec.clear();
+    return static_cast<size_t>(n);
+#else
+    (void)socket; (void)buffers; (void)count; (void)offset;
+    ec = notSupported();
+    return 0;
+#endif
+}
+
+bool nextCompletion(NativeSocket socket, uint32_t& last, bool& copied) {
+#if defined(__linux__) && defined(SO_EE_ORIGIN_ZEROCOPY)
+    char control[128];
+    msghdr msg{};
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    while (true) {
+        if (::recvmsg(socket, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+            bool recverr = (cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+                           (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR);
+            if (!recverr) {
+                continue;
+            }
+            auto* err = reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cm));
+            if (err->ee_errno != 0 || err->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                continue;
+            }
+            last = err->ee_data;  // Completed IDs are [ee_info, ee_data]
+            copied = (err->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+            return true;
+        }
+
+        // Something other than a completion; look at the next entry
+        msg.msg_controllen = sizeof(control);
+    }
+#else
+    (void)socket; (void)last; (void)copied;
+    return false;
+#endif
+}
+
+} // namespace zerocopy
+
+} // namespace asioclient